@@ -15,8 +15,26 @@ if(BUILD_OPENMP)
     list(APPEND OPENMP OpenMP::OpenMP_CXX OpenMP::OpenMP_Fortran)
 endif()
 
-# Optional profiler string length
-option(STRING_LENGTH "Maximum identifer string length" 100)
+# Default clock backend, which the VERNIER_CLOCK environment variable overrides
+set(VERNIER_DEFAULT_CLOCK "steady" CACHE STRING
+    "Default clock backend: steady, monotonic_raw, monotonic_coarse or tsc")
+set_property(CACHE VERNIER_DEFAULT_CLOCK PROPERTY STRINGS
+    steady monotonic_raw monotonic_coarse tsc)
+
+# Highest instrumentation level compiled into client code. Callipers tagged
+# with a higher level compile to nothing. Client targets may override it by
+# setting their own VERNIER_MAX_LEVEL property. Empty keeps every level.
+set(VERNIER_MAX_LEVEL "" CACHE STRING
+    "Highest instrumentation level compiled into client code, or empty for all")
+
+set(VERNIER_TARGET_MAX_LEVEL "$<TARGET_PROPERTY:VERNIER_MAX_LEVEL>")
+if(VERNIER_MAX_LEVEL STREQUAL "")
+    set(VERNIER_MAX_LEVEL_DEFINITION
+        "$<$<NOT:$<STREQUAL:${VERNIER_TARGET_MAX_LEVEL},>>:VERNIER_MAX_LEVEL=${VERNIER_TARGET_MAX_LEVEL}>")
+else()
+    set(VERNIER_MAX_LEVEL_DEFINITION
+        "VERNIER_MAX_LEVEL=$<IF:$<STREQUAL:${VERNIER_TARGET_MAX_LEVEL},>,${VERNIER_MAX_LEVEL},${VERNIER_TARGET_MAX_LEVEL}>")
+endif()
 
 # Whether to create a vernier.pc pkgc-config file
 option(ENABLE_PKGCONFIG "Enable pkg-config support" ON)
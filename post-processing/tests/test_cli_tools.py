@@ -71,3 +71,40 @@ class TestCLITools(unittest.TestCase):
             check=False
         )
         self.assertEqual(result.returncode, 2)
+
+    def test_vernier_manifest_dir(self):
+        """
+        Tests the vernier_manifest python script on a directory, excluding
+        regions by their mean time per call.
+        """
+        result = subprocess.run(
+            [str(self.tools_dir / 'vernier_manifest.py'),
+             str(self.test_data_dir / 'vernier-output-default-format'),
+             '--min-mean', '1.5'],
+            capture_output=True,
+            text=True,
+            check=False
+        )
+        self.assertEqual(result.returncode, 0)
+        lines = [line for line in result.stdout.splitlines()
+                 if not line.startswith('#')]
+        self.assertEqual(['regions 4', 'exclude MAIN_SUB2'], lines)
+
+    def test_vernier_manifest_overhead(self):
+        """
+        Tests that the vernier_manifest python script excludes regions whose
+        calliper cost is too large a fraction of their time.
+        """
+        result = subprocess.run(
+            [str(self.tools_dir / 'vernier_manifest.py'),
+             str(self.test_data_dir / 'vernier-output-default-format'),
+             '--min-mean', '0', '--max-overhead', '1.0e-5'],
+            capture_output=True,
+            text=True,
+            check=False
+        )
+        self.assertEqual(result.returncode, 0)
+        lines = [line for line in result.stdout.splitlines()
+                 if not line.startswith('#')]
+        self.assertEqual(['regions 4', 'exclude MAIN_SUB', 'exclude MAIN_SUB2'],
+                         lines)
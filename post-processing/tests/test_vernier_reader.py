@@ -145,6 +145,44 @@ class TestVernierReader(unittest.TestCase):
         self.assertCountEqual(loaded_data.data["MAIN_SUB2"].cumul_time, [5.0, 7.001, 8.001, 9.001, 5.008, 6.01, 7.012, 8.012])
         self.assertCountEqual(loaded_data.data["MAIN_SUB2"].rank, [0, 0, 0, 0, 1, 1, 1, 1])
         self.assertCountEqual(loaded_data.data["MAIN_SUB2"].thread, [3, 0, 2, 1, 1, 3, 0, 2])
+    def test_load_sampled_default_format(self):
+        test_reader = VernierReader(self.test_data_dir / "vernier-output-default-sampled")
+        loaded_data = test_reader.load()
+        self.assertCountEqual(loaded_data.data["kernel"].n_calls, [200])
+        self.assertCountEqual(loaded_data.data["kernel"].total_time, [0.000557382])
+        self.assertCountEqual(loaded_data.data["main"].n_calls, [1])
+        self.assertCountEqual(loaded_data.data["main"].self_time, [0.0])
+
+    def test_load_sampled_drhook_format(self):
+        test_reader = VernierReader(self.test_data_dir / "vernier-output-drhook-sampled")
+        loaded_data = test_reader.load()
+        self.assertCountEqual(loaded_data.data["kernel"].n_calls, [200])
+        self.assertCountEqual(loaded_data.data["kernel"].thread, [0])
+        self.assertCountEqual(loaded_data.data["main"].n_calls, [1])
+        self.assertCountEqual(loaded_data.data["main"].total_time, [0.001])
+    def test_load_throttled_drhook_format(self):
+        test_reader = VernierReader(self.test_data_dir / "vernier-output-drhook-throttled")
+        loaded_data = test_reader.load()
+        self.assertIn("kernel", loaded_data.data)
+        self.assertCountEqual(loaded_data.data["kernel"].n_calls, [200])
+        self.assertCountEqual(loaded_data.data["main"].n_calls, [1])
+        self.assertCountEqual(loaded_data.data["main"].thread, [0])
+
+    def test_load_counted_default_format(self):
+        test_reader = VernierReader(self.test_data_dir / "vernier-output-default-counted")
+        loaded_data = test_reader.load()
+        self.assertCountEqual(loaded_data.data["kernel"].n_calls, [20])
+        self.assertCountEqual(loaded_data.data["kernel"].self_time, [6.293e-06])
+        self.assertCountEqual(loaded_data.data["main"].n_calls, [1])
+        self.assertNotIn("halo_exchange", loaded_data.data)
+
+    def test_load_counted_drhook_format(self):
+        test_reader = VernierReader(self.test_data_dir / "vernier-output-drhook-counted")
+        loaded_data = test_reader.load()
+        self.assertCountEqual(loaded_data.data["kernel"].n_calls, [20])
+        self.assertCountEqual(loaded_data.data["kernel"].time_percent, [52.058])
+        self.assertCountEqual(loaded_data.data["main"].n_calls, [1])
+        self.assertNotIn("halo_exchange", loaded_data.data)
 
 if __name__ == '__main__':
     unittest.main()
@@ -83,6 +83,7 @@ class VernierReader():
         loaded = VernierData()
 
         calliper_data_section = False
+        event_data_section = False
 
         # Add EOF line to ensure percentage calculation is triggered at end of
         # file
@@ -96,6 +97,14 @@ class VernierReader():
                     rank = int(sline[-1]) # Extract rank number from the data line
                     continue
 
+                # Event counts are in their own table after the timings, which
+                # is not loaded
+                if sline[0] == "Counted":
+                    event_data_section = True
+                    continue
+                if event_data_section:
+                    continue
+
                 # If line matches the beginning of a calliper data section of
                 # the file, set this switch accordingly and reset temporaries
                 if "--------------" in sline:
@@ -131,6 +140,7 @@ class VernierReader():
                         loaded.data[calliper].time_percent.append(
                             (pc_self_times[key]/max_tot_time)*100)
                 calliper_data_section = False
+                event_data_section = False
 
         if not loaded.data:
             raise ValueError(f"No calliper data found in file '{self.path}'.")
@@ -151,12 +161,22 @@ class VernierReader():
 
         loaded = VernierData()
 
+        event_data_section = False
+
         # Populate data
         for line in file_contents:
             sline = line.split()
             if len(sline) > 0: # Line contains data
                 if sline[0] == "Task":
                     rank = int(sline[-1]) # Extract rank number from the data line
+                    event_data_section = False
+
+                # Event counts are in their own table after the timings, which
+                # is not loaded
+                if sline[0] == "Counted":
+                    event_data_section = True
+                if event_data_section:
+                    continue
 
                 if sline[0].isdigit(): # Calliper lines start with a digit
                     calliper, thread = sline[-1].split('@')
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+# ------------------------------------------------------------------------------
+#  (c) Crown copyright Met Office. All rights reserved.
+#  The file LICENCE, distributed with this code, contains details of the terms
+#  under which the code may be used.
+# ------------------------------------------------------------------------------
+"""
+Generates a Vernier manifest from a previous profile. The manifest is a filter
+file, to be given to VERNIER_FILTER_FILE, that excludes regions too short to be
+worth timing, and gives the number of regions to reserve space for.
+"""
+from pathlib import Path
+import argparse
+import sys
+sys.path.append(str(Path(__file__).parent.parent.parent))
+from vernier import VernierData, VernierReader
+
+# Name of the region holding the profiler's own overhead.
+PROFILER_REGION = "__vernier__"
+
+
+def process_args():
+    """
+    Take the vernier output path and exclusion thresholds as command-line
+    arguments.
+    """
+    parser = argparse.ArgumentParser(
+        description="Generate a Vernier manifest from a previous profile."
+    )
+    parser.add_argument(
+        "vernier_output",
+        type=Path,
+        help="Path to the Vernier output file or directory."
+    )
+    parser.add_argument(
+        "--min-mean",
+        type=float,
+        default=1.0e-6,
+        help="Exclude regions whose mean time per call, in seconds, is below "
+             "this. The default is 1.0e-6."
+    )
+    parser.add_argument(
+        "--max-overhead",
+        type=float,
+        default=1.0,
+        help="Exclude regions whose calliper cost per call, as a fraction of "
+             "their mean time per call, is above this. The default is 1."
+    )
+    parser.add_argument(
+        "-o", "--output",
+        type=Path,
+        help="Path to write the manifest to, instead of the terminal."
+    )
+
+    return parser.parse_args()
+
+
+def mean_time_per_call(total_time: list[float], n_calls: list[int]) -> float:
+    """
+    Mean inclusive time per call, over all ranks and threads.
+
+    :param total_time: Total times of a region on each rank and thread.
+    :param n_calls: Numbers of calls of the region on each rank and thread.
+    :return: The mean time per call in seconds, or 0 if it was never called.
+    """
+    calls = sum(n_calls)
+    return sum(total_time) / calls if calls > 0 else 0.0
+
+
+def escape_pattern(region_name: str) -> str:
+    """
+    Escapes the glob metacharacters in a region name, so that it is matched
+    literally.
+
+    :param region_name: The region name.
+    :return: A pattern that matches only the region name.
+    """
+    return "".join("\\" + char if char in "*?[\\" else char
+                   for char in region_name)
+
+
+def build_manifest(timers: VernierData, min_mean: float,
+                   max_overhead: float) -> tuple[int, list[str]]:
+    """
+    Works out the regions to exclude, and the number of regions to reserve.
+
+    :param timers: The previous profile.
+    :param min_mean: Minimum mean time per call of a region, in seconds.
+    :param max_overhead: Maximum calliper cost per call, as a fraction of the
+                         mean time per call.
+    :return: The largest number of regions on any rank and thread, and the
+             names of the regions to exclude.
+    """
+    # The profiler region accumulates the cost of every calliper pair.
+    calliper_cost = 0.0
+    if PROFILER_REGION in timers.data:
+        profiler = timers.data[PROFILER_REGION]
+        calliper_cost = mean_time_per_call(profiler.total_time,
+                                           profiler.n_calls)
+
+    regions_per_thread: dict[tuple[int, int], int] = {}
+    excluded = []
+    for name, calliper in timers.data.items():
+        for rank, thread in zip(calliper.rank, calliper.thread):
+            regions_per_thread[(rank, thread)] = (
+                regions_per_thread.get((rank, thread), 0) + 1)
+
+        if name == PROFILER_REGION:
+            continue
+        mean = mean_time_per_call(calliper.total_time, calliper.n_calls)
+        if mean < min_mean or calliper_cost > max_overhead * mean:
+            excluded.append(name)
+
+    return max(regions_per_thread.values(), default=0), sorted(excluded)
+
+
+def main():
+    """
+    Main function to process Vernier output and write a manifest.
+    """
+    args = process_args()
+    timers = VernierReader(args.vernier_output).load()
+    regions, excluded = build_manifest(timers, args.min_mean,
+                                       args.max_overhead)
+
+    lines = [f"# Vernier manifest generated from {args.vernier_output}",
+             f"# Excludes regions under {args.min_mean} s per call, or with "
+             f"calliper costs over {args.max_overhead} of their time.",
+             f"regions {regions}"]
+    lines += [f"exclude {escape_pattern(name)}" for name in excluded]
+    manifest = "\n".join(lines) + "\n"
+
+    if args.output is None:
+        sys.stdout.write(manifest)
+    else:
+        args.output.write_text(manifest, encoding="utf-8")
+
+
+if __name__ == "__main__":
+    main()
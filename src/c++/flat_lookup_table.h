@@ -0,0 +1,263 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+/**
+ *  @file   flat_lookup_table.h
+ *  @brief  Open-addressing map from region hashes to region record indices.
+ *
+ *  Keys and values are stored inline in a single power-of-two array, and
+ *  collisions are resolved by linear probing. A lookup therefore touches one
+ *  or two adjacent cache lines, rather than chasing bucket and node pointers
+ *  as std::unordered_map does.
+ *
+ *  Keys are region name hashes, which are already well mixed, so the low bits
+ *  of the key are used directly as the home slot.
+ *
+ */
+
+#ifndef VERNIER_FLAT_LOOKUP_TABLE_H
+#define VERNIER_FLAT_LOOKUP_TABLE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "hashvec.h"
+
+namespace meto {
+
+/**
+ * @brief  Flat hashtable holding the locations of region records.
+ *
+ * The table is kept at most half full, so that probe sequences stay short.
+ * It doubles in size when that load is exceeded; reserving enough slots up
+ * front means it never rehashes in steady state.
+ *
+ */
+
+class FlatLookupTable {
+
+public:
+  /**
+   * @brief  A single slot: a region hash and the index of its record.
+   */
+
+  struct Slot {
+    std::size_t hash_;
+    record_index_t index_;
+  };
+
+  /**
+   * @brief  Iterates over the occupied slots, in no particular order.
+   */
+
+  class const_iterator {
+  private:
+    Slot const *slot_;
+    Slot const *end_;
+
+    void skip_empty() {
+      while (slot_ != end_ && slot_->index_ == empty_) {
+        ++slot_;
+      }
+    }
+
+  public:
+    const_iterator(Slot const *slot, Slot const *end)
+        : slot_(slot), end_(end) {
+      skip_empty();
+    }
+
+    Slot const &operator*() const { return *slot_; }
+    Slot const *operator->() const { return slot_; }
+
+    const_iterator &operator++() {
+      ++slot_;
+      skip_empty();
+      return *this;
+    }
+
+    bool operator!=(const_iterator const &other) const {
+      return slot_ != other.slot_;
+    }
+  };
+
+private:
+  // Record index marking an empty slot. Never a valid record index.
+  static constexpr record_index_t empty_ = ~record_index_t{0};
+
+  // Slots, and the mask that maps a hash onto a slot.
+  std::vector<Slot> slots_;
+  std::size_t mask_ = 0;
+  std::size_t size_ = 0;
+
+  std::size_t home_slot(std::size_t const hash) const { return hash & mask_; }
+  std::size_t find_slot(std::size_t const) const;
+  void rehash(std::size_t const);
+
+public:
+  // Constructors
+  FlatLookupTable() { reserve(1); }
+
+  // Member functions
+  void reserve(std::size_t const);
+  bool find(std::size_t const, record_index_t &) const;
+  void insert_or_assign(std::size_t const, record_index_t const);
+  void erase(std::size_t const);
+  record_index_t at(std::size_t const) const;
+  bool contains(std::size_t const hash) const {
+    return slots_[find_slot(hash)].index_ != empty_;
+  }
+  std::size_t size() const { return size_; }
+
+  // Iteration over occupied slots
+  const_iterator begin() const {
+    return const_iterator(slots_.data(), slots_.data() + slots_.size());
+  }
+  const_iterator end() const {
+    auto const slots_end = slots_.data() + slots_.size();
+    return const_iterator(slots_end, slots_end);
+  }
+};
+
+} // namespace meto
+
+/**
+ * @brief  Find the slot holding a hash, or else the empty slot that ends its
+ *         probe sequence.
+ * @param [in] hash  The region hash.
+ * @returns  Index of the slot.
+ */
+
+inline std::size_t
+meto::FlatLookupTable::find_slot(std::size_t const hash) const {
+  auto slot = home_slot(hash);
+  while (slots_[slot].index_ != empty_ && slots_[slot].hash_ != hash) {
+    slot = (slot + 1) & mask_;
+  }
+  return slot;
+}
+
+/**
+ * @brief  Look up the record index for a hash.
+ * @param [in]  hash          The region hash.
+ * @param [out] record_index  The record index, if found.
+ * @returns  True if the hash is present.
+ */
+
+inline bool meto::FlatLookupTable::find(std::size_t const hash,
+                                        record_index_t &record_index) const {
+  auto const &slot = slots_[find_slot(hash)];
+  if (slot.index_ == empty_) {
+    return false;
+  }
+  record_index = slot.index_;
+  return true;
+}
+
+/**
+ * @brief  Look up the record index for a hash that must be present.
+ * @param [in] hash  The region hash.
+ * @returns  The record index.
+ * @throws  std::out_of_range if the hash is not present, as for
+ *          std::unordered_map::at.
+ */
+
+inline meto::record_index_t
+meto::FlatLookupTable::at(std::size_t const hash) const {
+  record_index_t record_index = 0;
+  if (!find(hash, record_index)) {
+    throw std::out_of_range("FlatLookupTable::at");
+  }
+  return record_index;
+}
+
+/**
+ * @brief  Insert a hash, or update its record index if already present.
+ * @param [in] hash          The region hash.
+ * @param [in] record_index  The record index.
+ */
+
+inline void
+meto::FlatLookupTable::insert_or_assign(std::size_t const hash,
+                                        record_index_t const record_index) {
+  auto slot = find_slot(hash);
+  if (slots_[slot].index_ == empty_) {
+    // Keep the table at most half full.
+    if (2 * (size_ + 1) > slots_.size()) {
+      rehash(2 * slots_.size());
+      slot = find_slot(hash);
+    }
+    slots_[slot].hash_ = hash;
+    ++size_;
+  }
+  slots_[slot].index_ = record_index;
+}
+
+/**
+ * @brief  Remove a hash, if present.
+ * @param [in] hash  The region hash.
+ * @note   Later entries in the probe sequence are shifted back into the gap,
+ *         so that no tombstones are needed.
+ */
+
+inline void meto::FlatLookupTable::erase(std::size_t const hash) {
+  auto gap = find_slot(hash);
+  if (slots_[gap].index_ == empty_) {
+    return;
+  }
+  --size_;
+
+  auto slot = gap;
+  while (true) {
+    slot = (slot + 1) & mask_;
+    if (slots_[slot].index_ == empty_) {
+      break;
+    }
+    // An entry may fill the gap only if its home slot does not lie cyclically
+    // in (gap, slot].
+    auto const home = home_slot(slots_[slot].hash_);
+    if (((slot - home) & mask_) >= ((slot - gap) & mask_)) {
+      slots_[gap] = slots_[slot];
+      gap = slot;
+    }
+  }
+  slots_[gap].index_ = empty_;
+}
+
+/**
+ * @brief  Ensure that a number of entries can be held without rehashing.
+ * @param [in] count  The number of entries.
+ */
+
+inline void meto::FlatLookupTable::reserve(std::size_t const count) {
+  std::size_t capacity = 2;
+  while (capacity < 2 * count) {
+    capacity *= 2;
+  }
+  if (capacity > slots_.size()) {
+    rehash(capacity);
+  }
+}
+
+/**
+ * @brief  Move all entries into a new array of slots.
+ * @param [in] capacity  The new number of slots, a power of two.
+ */
+
+inline void meto::FlatLookupTable::rehash(std::size_t const capacity) {
+  std::vector<Slot> old_slots(capacity, Slot{0, empty_});
+  old_slots.swap(slots_);
+  mask_ = capacity - 1;
+
+  for (auto const &old_slot : old_slots) {
+    if (old_slot.index_ != empty_) {
+      slots_[find_slot(old_slot.hash_)] = old_slot;
+    }
+  }
+}
+
+#endif
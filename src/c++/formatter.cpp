@@ -47,11 +47,128 @@ meto::Formatter::Formatter() {
  * @param[inout] header  Output stream for the format header
  * @param[inout] os      Output stream for the format method will write data to
  * @param[in]    hashvec Vector of data that the format method will operate on
+ * @param[in]    notes   Notes on how the profile was taken
  */
 
 void meto::Formatter::execute_format(std::ostream &header, std::ostream &os,
-                                     const hashvec_t &hashvec) {
-  (this->*format_)(header, os, hashvec);
+                                     const hashvec_t &hashvec,
+                                     const profile_notes_t &notes) {
+  (this->*format_)(header, os, hashvec, notes);
+}
+
+/**
+ * @brief  Whether any region has warm-up calls, which are then written in
+ *         separate columns.
+ *
+ * @param[in] hashvec  Vector containing all the necessary data
+ */
+
+bool meto::Formatter::has_warmup(const hashvec_t &hashvec) {
+  return std::any_of(std::begin(hashvec), std::end(hashvec),
+                     [](auto const &record) {
+                       return record.warmup_.call_count_ > 0;
+                     });
+}
+
+/**
+ * @brief  Markers flagging a region whose times are estimates or incomplete.
+ *
+ * @param[in] record  The region record
+ * @returns  "*" if the region or one of its children was sampled, and "#" if
+ *           the region was throttled, separated by a space if both apply.
+ *           An empty string if neither applies.
+ */
+
+std::string meto::Formatter::markers(const RegionRecord &record) {
+  std::string marker;
+  if (record.untimed_call_count_ > 0 || record.estimated_child_time_) {
+    marker = "*";
+  }
+  if (record.throttled_) {
+    marker += marker.empty() ? "#" : " #";
+  }
+  return marker;
+}
+
+/**
+ * @brief  Whether any region is flagged with a marker, which the Dr Hook
+ *         format then writes in its own column.
+ *
+ * @param[in] hashvec  Vector containing all the necessary data
+ */
+
+bool meto::Formatter::has_markers(const hashvec_t &hashvec) {
+  return std::any_of(
+      std::begin(hashvec), std::end(hashvec),
+      [](auto const &record) { return !markers(record).empty(); });
+}
+
+/**
+ * @brief  Writes the warm-up time and number of calls of a region.
+ *
+ * @param[inout] os      Output stream to write to
+ * @param[in]    record  The region record
+ * @param[in]    width   Width of each column
+ */
+
+void meto::Formatter::write_warmup(std::ostream &os, const RegionRecord &record,
+                                   int const width) {
+  os << std::setw(width) << std::right
+     << ticks_to_seconds(record.warmup_.total_walltime_ +
+                         record.warmup_.recursion_total_walltime_)
+     << std::setw(width) << std::right << record.warmup_.call_count_;
+}
+
+/**
+ * @brief  Whether any region has counted events, which are then written in
+ *         their own table.
+ *
+ * @param[in] hashvec  Vector containing all the necessary data
+ */
+
+bool meto::Formatter::has_events(const hashvec_t &hashvec) {
+  return std::any_of(
+      std::begin(hashvec), std::end(hashvec),
+      [](auto const &record) { return record.event_count_ > 0; });
+}
+
+/**
+ * @brief  Whether a region has a row in the timings table. Regions that were
+ *         only counted are left out, and appear only in the event table.
+ *
+ * @param[in] record  The region record
+ */
+
+bool meto::Formatter::is_timed(const RegionRecord &record) {
+  return record.call_count_ > 0 || record.warmup_.call_count_ > 0;
+}
+
+/**
+ * @brief  Writes the event counts of all counted regions as a separate table,
+ *         which is headed "Counted region" so that readers can tell it apart
+ *         from the timings. Nothing is written if no events were counted.
+ *
+ * @param[inout] os       Output stream to write to
+ * @param[in]    hashvec  Vector containing all the necessary data
+ * @param[in]    indent   Indent at the start of each line
+ */
+
+void meto::Formatter::write_events(std::ostream &os, const hashvec_t &hashvec,
+                                   std::string const &indent) {
+  if (!has_events(hashvec)) {
+    return;
+  }
+
+  os << "\n";
+  os << indent << std::setw(45) << std::left << "Counted region"
+     << std::setw(15) << std::right << "Events" << "\n";
+  for (auto const &record : hashvec) {
+    if (record.event_count_ > 0) {
+      os << indent << std::setw(45) << std::left
+         << record.decorated_region_name_ << std::setw(15) << std::right
+         << record.event_count_ << "\n";
+    }
+  }
 }
 
 /**
@@ -60,10 +177,15 @@ void meto::Formatter::execute_format(std::ostream &header, std::ostream &os,
  * @param[inout] header   Output stream for the format header
  * @param[inout] os       Output stream to write to
  * @param[in]    hashvec  Vector containing all the necessary data
+ * @param[in]    notes    Notes on how the profile was taken, written after the
+ *                        legend
  */
 
 void meto::Formatter::default_output(std::ostream &header, std::ostream &os,
-                                     const hashvec_t &hashvec) {
+                                     const hashvec_t &hashvec,
+                                     const profile_notes_t &notes) {
+
+  bool const warmup = has_warmup(hashvec);
 
   // Write header
   header << "\n";
@@ -74,28 +196,65 @@ void meto::Formatter::default_output(std::ostream &header, std::ostream &os,
          << "Overhead  : Profiling overhead incurred through direct child "
             "routine calls only.\n"
          << "Calls     : Number of times the region is called.\n";
+  if (has_events(hashvec)) {
+    header << "Events    : Number of events counted against the region. (In "
+              "own table.)\n";
+  }
+  if (warmup) {
+    header << "Warm-up   : Total time and number of calls before the region "
+              "reached a steady state. (Not in other columns.)\n";
+  }
+  for (auto const &note : notes) {
+    header << note << "\n";
+  }
 
   // Write headings
   os << "\n";
   os << std::setw(45) << std::left << "Region" << std::setw(15) << std::right
      << "Self (s)" << std::setw(15) << std::right << "Total (s)"
      << std::setw(15) << std::right << "Overhead (s)" << std::setw(10)
-     << std::right << "Calls\n";
+     << std::right << "Calls";
+  if (warmup) {
+    os << std::setw(15) << std::right << "Warm-up (s)" << std::setw(15)
+       << std::right << "Warm-up calls";
+  }
+  os << "\n";
 
   os << std::setfill('-');
   os << std::left;
   os << std::setw(45) << "" << std::setw(15) << " " << std::setw(15) << " "
-     << std::setw(15) << " " << std::setw(10) << " " << std::endl;
+     << std::setw(15) << " " << std::setw(10) << " ";
+  if (warmup) {
+    os << std::setw(15) << " " << std::setw(15) << " ";
+  }
+  os << std::endl;
   os << std::setfill(' ');
 
   // Data entries
   for (auto const &record : hashvec) {
+
+    if (!is_timed(record)) {
+      continue;
+    }
+
     os << std::setw(45) << std::left << record.decorated_region_name_
-       << std::setw(15) << std::right << record.self_walltime_.count()
-       << std::setw(15) << std::right << record.total_walltime_.count()
-       << std::setw(15) << std::right << record.overhead_walltime_.count()
-       << std::setw(10) << std::right << record.call_count_ << "\n";
+       << std::setw(15) << std::right
+       << ticks_to_seconds(record.self_walltime_) << std::setw(15)
+       << std::right << ticks_to_seconds(record.total_walltime_)
+       << std::setw(15) << std::right
+       << ticks_to_seconds(record.overhead_walltime_)
+       << std::setw(10) << std::right << record.call_count_;
+    if (warmup) {
+      write_warmup(os, record, 15);
+    }
+    auto const marker = markers(record);
+    if (!marker.empty()) {
+      os << " " << marker;
+    }
+    os << "\n";
   }
+
+  write_events(os, hashvec, "");
 }
 
 /**
@@ -105,10 +264,16 @@ void meto::Formatter::default_output(std::ostream &header, std::ostream &os,
  * @param header       Header stream to write to
  * @param[in] os       Output stream to write to
  * @param[in] hashvec  Vector containing all the necessary data
+ * @param[in] notes    Notes on how the profile was taken, written after the
+ *                     thread count
  */
 
 void meto::Formatter::drhook([[maybe_unused]] std::ostream &header,
-                             std::ostream &os, const hashvec_t &hashvec) {
+                             std::ostream &os, const hashvec_t &hashvec,
+                             const profile_notes_t &notes) {
+
+  bool const warmup = has_warmup(hashvec);
+  bool const marked = has_markers(hashvec);
 
   int num_threads = 1;
 #ifdef _OPENMP
@@ -116,6 +281,9 @@ void meto::Formatter::drhook([[maybe_unused]] std::ostream &header,
 #endif
   // Preliminary info
   os << "Profiling on " << num_threads << " thread(s).\n";
+  for (auto const &note : notes) {
+    os << note << "\n";
+  }
 
   // Table Headers
   os << "\n";
@@ -123,8 +291,16 @@ void meto::Formatter::drhook([[maybe_unused]] std::ostream &header,
      << "% Time" << std::setw(13) << std::right << "Cumul" << std::setw(13)
      << std::right << "Self" << std::setw(13) << std::right << "Total"
      << std::setw(15) << std::right << "# of calls" << std::setw(12)
-     << std::right << "Self" << std::setw(12) << std::right << "Total    "
-     << "Routine@\n";
+     << std::right << "Self" << std::setw(12) << std::right << "Total    ";
+  if (warmup) {
+    // The heading before the routine name carries its four-space gap.
+    os << std::setw(8) << std::right << "Warm-up" << std::setw(16)
+       << std::right << "Warm-up    ";
+  }
+  if (marked) {
+    os << std::setw(PROF_DRHOOK_MARKER_WIDTH) << "";
+  }
+  os << "Routine@\n";
   os << "    " << std::setw(73) << ""
      << "(Size; Size/sec; Size/call; MinSize; MaxSize)\n";
 
@@ -133,20 +309,25 @@ void meto::Formatter::drhook([[maybe_unused]] std::ostream &header,
      << "(self)" << std::setw(13) << std::right << "(sec)" << std::setw(13)
      << std::right << "(sec)" << std::setw(13) << std::right << "(sec)"
      << std::setw(15) << std::right << "" << std::setw(12) << std::right
-     << "ms/call" << std::setw(12) << std::right << "ms/call\n\n";
+     << "ms/call" << std::setw(12) << std::right << "ms/call";
+  if (warmup) {
+    os << std::setw(12) << std::right << "(sec)" << std::setw(12)
+       << std::right << "calls";
+  }
+  os << "\n\n";
 
   // Find the highest walltime in table_, which should be the total runtime of
   // the program. This is used later when calculating '% Time'.
-  double top_walltime =
+  double top_walltime = ticks_to_seconds(
       std::max_element(
           std::begin(hashvec), std::end(hashvec),
           [](auto a, auto b) { return a.total_walltime_ < b.total_walltime_; })
-          ->total_walltime_.count();
+          ->total_walltime_);
 
   // Declare any variables external to RegionRecord
   int region_number = 0;
   double percent_time;
-  time_duration_t cumul_walltime = time_duration_t::zero();
+  time_duration_t cumul_walltime = 0;
   double self_per_call;
   double total_per_call;
 
@@ -158,23 +339,47 @@ void meto::Formatter::drhook([[maybe_unused]] std::ostream &header,
 
   for (auto const &record : hashvec) {
 
+    if (!is_timed(record)) {
+      continue;
+    }
+
     // Calculate non-RegionRecord data
     region_number++;
-    percent_time = 100.0 * (record.self_walltime_.count() / top_walltime);
+
+    double const self_walltime = ticks_to_seconds(record.self_walltime_);
+    double const total_walltime = ticks_to_seconds(record.total_walltime_);
+    percent_time = 100.0 * (self_walltime / top_walltime);
     cumul_walltime += record.self_walltime_;
-    self_per_call = 1000.0 * (record.self_walltime_.count() /
-                              static_cast<double>(record.call_count_));
-    total_per_call = 1000.0 * (record.total_walltime_.count() /
-                               static_cast<double>(record.call_count_));
+
+    // A region with only warm-up calls has no steady-state time per call.
+    self_per_call = 0.0;
+    total_per_call = 0.0;
+    if (record.call_count_ > 0) {
+      self_per_call =
+          1000.0 * (self_walltime / static_cast<double>(record.call_count_));
+      total_per_call =
+          1000.0 * (total_walltime / static_cast<double>(record.call_count_));
+    }
 
     // Write everything out
     os << "    " << std::setw(3) << std::left << region_number << std::setw(7)
        << std::right << percent_time << std::setw(13) << std::right
-       << cumul_walltime.count() << std::setw(13) << std::right
-       << record.self_walltime_.count() << std::setw(13) << std::right
-       << record.total_walltime_.count() << std::setw(15) << std::right
-       << record.call_count_ << std::setw(12) << std::right << self_per_call
-       << std::setw(12) << std::right << total_per_call << "    "
-       << record.decorated_region_name_ << "\n";
+       << ticks_to_seconds(cumul_walltime) << std::setw(13) << std::right
+       << self_walltime << std::setw(13) << std::right << total_walltime
+       << std::setw(15) << std::right << record.call_count_ << std::setw(12)
+       << std::right << self_per_call << std::setw(12) << std::right
+       << total_per_call;
+    if (warmup) {
+      write_warmup(os, record, 12);
+    }
+
+    // Markers go in their own column, so that the routine name stays last.
+    if (marked) {
+      os << std::setw(PROF_DRHOOK_MARKER_WIDTH) << std::right
+         << markers(record);
+    }
+    os << "    " << record.decorated_region_name_ << "\n";
   }
+
+  write_events(os, hashvec, "    ");
 }
@@ -17,6 +17,8 @@
 
 #include <fstream>
 #include <ostream>
+#include <string>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -25,8 +27,16 @@
 #include "hashvec.h"
 #include "mpi_context.h"
 
+// Width of the Dr Hook marker column, written before the routine name when
+// any region is flagged.
+#define PROF_DRHOOK_MARKER_WIDTH 4
+
 namespace meto {
 
+// Notes describing how the profile was taken, such as non-default profiler
+// settings. Each note is written as one line of the output.
+using profile_notes_t = std::vector<std::string>;
+
 /**
  * @brief  Formatter class. Methods write profile data.
  * @note   Different formats are coded in different class methods. A function
@@ -40,12 +50,27 @@ class Formatter {
   std::string format_string_;
   // Format method
   void (Formatter::*format_)(std::ostream &header, std::ostream &os,
-                             const hashvec_t &hashvec);
+                             const hashvec_t &hashvec,
+                             const profile_notes_t &notes);
 
   // Individual formatter functions
   void default_output(std::ostream &header, std::ostream &os,
-                      const hashvec_t &hashvec);
-  void drhook(std::ostream &header, std::ostream &os, const hashvec_t &hashvec);
+                      const hashvec_t &hashvec, const profile_notes_t &notes);
+  void drhook(std::ostream &header, std::ostream &os, const hashvec_t &hashvec,
+              const profile_notes_t &notes);
+
+  // Markers flagging estimated times, and warm-up columns
+  static std::string markers(const RegionRecord &record);
+  static bool has_markers(const hashvec_t &hashvec);
+  static bool has_warmup(const hashvec_t &hashvec);
+  static void write_warmup(std::ostream &os, const RegionRecord &record,
+                           int const width);
+
+  // Event counts, written in their own table after the timings
+  static bool has_events(const hashvec_t &hashvec);
+  static bool is_timed(const RegionRecord &record);
+  static void write_events(std::ostream &os, const hashvec_t &hashvec,
+                           std::string const &indent);
 
 public:
   // Constructor
@@ -53,7 +78,7 @@ class Formatter {
 
   // Execute the format method
   void execute_format(std::ostream &header, std::ostream &os,
-                      const hashvec_t &hashvec);
+                      const hashvec_t &hashvec, const profile_notes_t &notes);
 
   [[nodiscard]] std::string get_format_string() const { return format_string_; }
 };
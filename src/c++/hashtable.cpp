@@ -5,25 +5,28 @@
 \*----------------------------------------------------------------------------*/
 
 #include "hashtable.h"
-#include "error_handler.h"
 #include "hashvec_handler.h"
+#include "vernier_hash.h"
 
-#include <array>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
-#include <cstring>
+#include <cstdint>
 #include <iterator>
-#include <sstream>
 
 /**
  * @brief Hashtable constructor
- * @param [in] tid  The thread ID.
+ * @param [in] tid       The thread ID.
+ * @param [in] capacity  The number of regions to reserve space for.
  *
  */
 
-meto::HashTable::HashTable(int const tid) : tid_(tid) {
+meto::HashTable::HashTable(int const tid, std::size_t const capacity)
+    : tid_(tid) {
   // Reserve enough places in hashvec_
-  hashvec_.reserve(PROF_HASHVEC_RESERVE_SIZE);
+  hashvec_.reserve(capacity);
+  lookup_table_.reserve(capacity);
 
   // Set the name and hash of the profiler entry.
   std::string const profiler_name = "__vernier__";
@@ -33,72 +36,37 @@ meto::HashTable::HashTable(int const tid) : tid_(tid) {
 }
 
 /**
- * @brief  Decorates a region name with the thread ID and computes the
- *         corresponding hash.
+ * @brief  Computes the hash of a region name.
  *
  * @param [in] region_name  The code region name.
- * @param [in] tid          The thread ID
  *
- * @returns  Returns a hash based on the input arguments.
+ * @returns  Returns a hash based on the region name alone.
  *
- * @note The integer thread ID is not converted to a string before it is
- *       appended to the hash string.  This is a performance measure.
- *       Conversions to strings are expensive and not strictly necessary.
- *       Since the physical bit pattern is unique for each integer, that
- *       will do the job. The hash function input does not need to be
- *       human-readable.
+ * @note The name is hashed in place, so it may be of any length. The hash
+ *       does not depend on the thread, since each thread has its own
+ *       hashtable, and so it identifies the region across threads and ranks.
  *
  */
 
-size_t meto::HashTable::compute_hash(std::string_view region_name, int tid) {
-
-  // Get the bit-pattern of the thread ID.
-  std::array<std::byte, sizeof(tid)> tid_bytes;
-  std::memcpy(tid_bytes.data(), &tid, sizeof(tid));
-
-  [[maybe_unused]] int const *tid_back =
-      reinterpret_cast<int const *>(tid_bytes.data());
-  assert(*tid_back == tid);
-
-  // Extra bytes to accommodate the thread ID.
-  unsigned int constexpr num_extra_bytes = sizeof(tid);
-
-  // Avoid dynamic memory allocation for performance reasons. Instead, fix the
-  // size of the buffer and perform a runtime check that we're not exceeding it.
-  std::array<char, PROF_STRING_BUFFER_LENGTH> new_chars;
-  new_chars.fill('\0');
-
-  if (region_name.length() + num_extra_bytes > new_chars.size()) {
-    std::stringstream message;
-    message << "Vernier internal error: region name too long ("
-            << region_name.length() << " > "
-            << new_chars.size() - num_extra_bytes << ")";
-    error_handler(message.str(), EXIT_FAILURE);
-  }
-
-  // Get iterator to the start of the string buffer.
-  auto new_chars_iterator = new_chars.begin();
-
-  // Copy the region name into the char buffer.
-  std::copy(region_name.begin(), region_name.end(), new_chars_iterator);
-  std::advance(new_chars_iterator, region_name.size());
-
-  // Add thread ID (physical representation)
-  std::memcpy(&(*new_chars_iterator), tid_bytes.data(), tid_bytes.size());
-  std::advance(new_chars_iterator, tid_bytes.size());
-
-  // Compute the length of the character array based on the current position of
-  // the iterator.
-  auto new_chars_size = std::distance(new_chars.begin(), new_chars_iterator);
+size_t meto::HashTable::compute_hash(std::string_view const region_name) {
+  return hash_region_name(region_name);
+}
 
-  // Check that the character string is the length which were expecting.
-  [[maybe_unused]] auto const expected_size =
-      static_cast<unsigned int>(region_name.length()) + num_extra_bytes;
-  assert(new_chars_size == expected_size);
+/**
+ * @brief  Finds the name cache entry for a region name.
+ * @param [in] region_name  The region name.
+ * @returns  The entry that this name, at this address, maps to.
+ *
+ */
 
-  return hash_function_(std::string_view(
-      new_chars.data(),
-      static_cast<std::string_view::size_type>(new_chars_size)));
+meto::HashTable::NameCacheEntry &
+meto::HashTable::name_cache_entry(std::string_view const region_name) {
+  // Multiplicative hash of the address, since neighbouring string literals
+  // differ only in their low bits.
+  std::uint64_t const mixed =
+      std::uint64_t{reinterpret_cast<std::uintptr_t>(region_name.data())} *
+      0x9e3779b97f4a7c15ULL;
+  return name_cache_[(mixed >> 32) % PROF_NAME_CACHE_SIZE];
 }
 
 /**
@@ -108,107 +76,394 @@ size_t meto::HashTable::compute_hash(std::string_view region_name, int tid) {
  * @param [out] hash          Hash of the region name.
  * @param [out] record_index  Array index of the region record.
  *
+ * @note  Names are first looked up by address in the name cache. The cached
+ *        record's name is compared with the one passed in, in case the
+ *        address has been reused for a different name.
+ *
  */
 
 void meto::HashTable::query_insert(std::string_view const region_name, int tid,
                                    size_t &hash,
                                    record_index_t &record_index) noexcept {
+  // Has this name been seen at this address before?
+  auto &cache_entry = name_cache_entry(region_name);
+  if (cache_entry.name_ == region_name.data() &&
+      cache_entry.length_ == region_name.size()) {
+    auto const &record = hashvec_[cache_entry.record_index_];
+    if (record.region_name_ == region_name) {
+      hash = record.region_hash_;
+      record_index = cache_entry.record_index_;
+      return;
+    }
+  }
+
   // Compute the hash
-  hash = compute_hash(region_name, tid);
+  hash = compute_hash(region_name);
 
-  // Does the entry exist already?
-  if (auto search = lookup_table_.find(hash); search != lookup_table_.end()) {
-    record_index = search->second;
-  }
+  // Does the entry exist already? If not, create new entry, unless the table
+  // is full.
+  if (!lookup_table_.find(hash, record_index)) {
+    if (max_regions_ > 0 && hashvec_.size() > max_regions_) {
+      fold_overflow(region_name, hash, record_index);
+      return;
+    }
 
-  // If not, create new entry.
-  else {
     // Insert this region into the thread's hash table.
     hashvec_.emplace_back(hash, region_name, tid);
     record_index = hashvec_.size() - 1;
-    lookup_table_.emplace(hash, record_index);
-    assert(lookup_table_.count(hash) > 0);
+    if (sample_rates_) {
+      hashvec_.back().sample_rate_ = sample_rates_->get_rate(hash);
+    }
+    if (region_filter_) {
+      hashvec_.back().filtered_ = region_filter_->is_filtered(region_name);
+    }
+    lookup_table_.insert_or_assign(hash, record_index);
+    assert(lookup_table_.contains(hash));
   }
+
+  cache_entry = {region_name.data(), region_name.size(), record_index, hash};
 }
 
 /**
- * @brief  Updates the total walltime and call count for the specified region.
- * @param [in] record_index  The index in hashvec_ corresponding to the
- *                           profiled region.
- * @param [in] time_delta  The time increment to add.
+ * @brief  Inserts a new indexed region into the hashtable.
+ * @param [in]  region_name   The name of the region.
+ * @param [in]  key           The integer key of the region.
+ * @param [in]  tid           The thread ID.
+ * @param [out] hash          Hash of the indexed region.
+ * @param [out] record_index  Array index of the region record.
+ *
+ * @note  The key is mixed into the hash of the name, and is only formatted
+ *        into the record name, as name[key], when the record is created.
+ *        Sample rates and filters are those of the name without the key.
+ *        The hash of the name is looked up by address in the name cache, as
+ *        in query_insert, so that repeated starts do not hash the name. The
+ *        cached record's name must be the name passed in, or begin with it
+ *        followed by '['.
  */
 
-void meto::HashTable::update(record_index_t const record_index,
-                             time_duration_t const time_delta) {
+void meto::HashTable::query_insert_indexed(
+    std::string_view const region_name, int const key, int tid, size_t &hash,
+    record_index_t &record_index) noexcept {
+
+  // Has this name been seen at this address before?
+  auto &cache_entry = name_cache_entry(region_name);
+  size_t name_hash = 0;
+  bool cached = false;
+  if (cache_entry.name_ == region_name.data() &&
+      cache_entry.length_ == region_name.size()) {
+    std::string_view const cached_name =
+        hashvec_[cache_entry.record_index_].region_name_;
+    cached = cached_name.substr(0, region_name.size()) == region_name &&
+             (cached_name.size() == region_name.size() ||
+              cached_name[region_name.size()] == '[');
+  }
+  if (cached) {
+    name_hash = cache_entry.name_hash_;
+  } else {
+    name_hash = compute_hash(region_name);
+  }
+  hash = hash_indexed_region(name_hash, key);
+
+  if (lookup_table_.find(hash, record_index)) {
+    if (!cached) {
+      cache_entry = {region_name.data(), region_name.size(), record_index,
+                     name_hash};
+    }
+    return;
+  }
 
-  auto &record = hashvec_[record_index];
+  if (max_regions_ > 0 && hashvec_.size() > max_regions_) {
+    fold_overflow(region_name, hash, record_index);
+    return;
+  }
 
-  // Increment the walltime for this hash entry. If this region has been called
-  // recursively, directly or indirectly, the time goes into a different bucket.
-  if (record.recursion_level_ > 0) {
-    record.recursion_total_walltime_ += time_delta;
-  } else {
-    record.total_walltime_ += time_delta;
+  std::string indexed_name(region_name);
+  indexed_name += '[';
+  indexed_name += std::to_string(key);
+  indexed_name += ']';
+
+  hashvec_.emplace_back(hash, indexed_name, tid);
+  record_index = hashvec_.size() - 1;
+  if (sample_rates_) {
+    hashvec_.back().sample_rate_ = sample_rates_->get_rate(name_hash);
+  }
+  if (region_filter_) {
+    hashvec_.back().filtered_ = region_filter_->is_filtered(region_name);
+  }
+  lookup_table_.insert_or_assign(hash, record_index);
+  assert(lookup_table_.contains(hash));
+
+  if (!cached) {
+    cache_entry = {region_name.data(), region_name.size(), record_index,
+                   name_hash};
+  }
+}
+
+/**
+ * @brief  Finds or creates the call-tree node for a region beneath a parent
+ *         node, and caches it in the parent's child cache.
+ * @param [in] parent_index  Array index of the parent node's record.
+ * @param [in] region_index  Array index of the region record.
+ * @returns  Array index of the node's record.
+ *
+ * @note  The node is named by its call path, and takes the sample rate of its
+ *        region. Nodes met once the table holds the maximum number of regions
+ *        are folded into an overflow record.
+ */
+
+meto::record_index_t
+meto::HashTable::insert_node(record_index_t const parent_index,
+                             record_index_t const region_index) {
+  auto hash = hash_call_path(hashvec_[parent_index].region_hash_,
+                             hashvec_[region_index].region_hash_);
+
+  record_index_t node_index = 0;
+  if (!lookup_table_.find(hash, node_index)) {
+    // Records may move as others are added, so take copies first.
+    std::string const region_name = hashvec_[region_index].region_name_;
+    auto const sample_rate = hashvec_[region_index].sample_rate_;
+
+    if (max_regions_ > 0 && hashvec_.size() > max_regions_) {
+      fold_overflow(region_name, hash, node_index);
+    } else {
+      std::string call_path = hashvec_[parent_index].region_name_;
+      call_path += PROF_CALL_PATH_SEPARATOR;
+      call_path += region_name;
+
+      hashvec_.emplace_back(hash, call_path, tid_);
+      node_index = hashvec_.size() - 1;
+      hashvec_.back().sample_rate_ = sample_rate;
+      lookup_table_.insert_or_assign(hash, node_index);
+    }
+  }
+
+  if (parent_index >= child_caches_.size()) {
+    child_caches_.resize(hashvec_.size());
+  }
+  child_caches_[parent_index][region_index & (PROF_CHILD_CACHE_SIZE - 1)] = {
+      region_index, node_index};
+  return node_index;
+}
+
+/**
+ * @brief  Folds a region name into an overflow record, once the table holds
+ *         the maximum number of regions.
+ * @param [in]  region_name   The name of the region.
+ * @param [out] hash          Hash of the overflow record.
+ * @param [out] record_index  Array index of the overflow record.
+ *
+ * @note  Names that are filtered out are folded into a separate record, which
+ *        is also filtered out. The overflow records are found by hash, since
+ *        writing the profile may move records.
+ *
+ */
+
+void meto::HashTable::fold_overflow(std::string_view const region_name,
+                                    size_t &hash,
+                                    record_index_t &record_index) {
+
+  // Note the name in the bitmap of folded names.
+  if (overflow_names_.empty()) {
+    overflow_names_.resize(PROF_OVERFLOW_BITMAP_WORDS, 0);
+  }
+  constexpr std::uint64_t bit_count = PROF_OVERFLOW_BITMAP_WORDS * 64;
+  std::uint64_t const bit =
+      ((std::uint64_t{hash} * 0x9e3779b97f4a7c15ULL) >> 32) % bit_count;
+  overflow_names_[bit / 64] |= std::uint64_t{1} << (bit % 64);
+
+  bool const filtered =
+      region_filter_ && region_filter_->is_filtered(region_name);
+  std::string_view const overflow_name =
+      filtered ? PROF_FILTERED_OVERFLOW_REGION : PROF_OVERFLOW_REGION;
+  hash = compute_hash(overflow_name);
+
+  if (!lookup_table_.find(hash, record_index)) {
+    hashvec_.emplace_back(hash, overflow_name, tid_);
+    record_index = hashvec_.size() - 1;
+    if (sample_rates_) {
+      hashvec_.back().sample_rate_ = sample_rates_->get_rate(hash);
+    }
+    hashvec_.back().filtered_ = filtered;
+    lookup_table_.insert_or_assign(hash, record_index);
   }
+}
+
+/**
+ * @brief  Stores the region record index for a pre-registered region handle.
+ * @param [in] handle        The region handle.
+ * @param [in] record_index  Array index of the region record.
+ *
+ */
 
-  // Update the number of times this region has been called
-  ++record.call_count_;
+void meto::HashTable::insert_handle(RegionHandle const handle,
+                                    record_index_t const record_index) {
+  if (handle.id_ >= handle_lookup_.size()) {
+    handle_lookup_.resize(handle.id_ + 1, handle_unset_);
+  }
+  handle_lookup_[handle.id_] = record_index;
 }
 
 /**
- * @brief  Increments by 1 the recursion level in a region record.
- * @param [in] record_index  The index corresponding to the region record.
+ * @brief  Sets the sample rates for regions met from now on.
+ * @param [in] sample_rates  The sample rates, which must outlive the table.
+ *
  */
 
-void meto::HashTable::increment_recursion_level(
-    record_index_t const record_index) {
-  auto &record = hashvec_[record_index];
-  ++record.recursion_level_;
+void meto::HashTable::set_sample_rates(SampleRates const &sample_rates) {
+  sample_rates_ = &sample_rates;
 }
 
 /**
- * @brief  Decrements by 1 the recursion level in a region record.
- * @param [in] record_index  The index corresponding to the region record.
+ * @brief  Sets the thresholds below which regions are no longer timed.
+ * @param [in] throttle_calls  The number of calls after which a region may be
+ *                             throttled.
+ * @param [in] throttle_ticks  The mean time per call, in clock ticks, below
+ *                             which a region is throttled.
+ *
  */
 
-void meto::HashTable::decrement_recursion_level(
-    record_index_t const record_index) {
-  auto &record = hashvec_[record_index];
-  --record.recursion_level_;
+void meto::HashTable::set_throttle(unsigned long long int const throttle_calls,
+                                   double const throttle_ticks) {
+  throttle_calls_ = throttle_calls;
+  throttle_ticks_ = throttle_ticks;
 }
 
 /**
- * @brief  Add in time spent calling child regions. Also retuns a pointer
- *         to the overhead time so that it can be incremented downstream,
- *         outside this function, with minimal additional overhead.
- * @param [in]  record_index   The index corresponding to the region record.
- * @param [in]  time_delta     The time spent in the child region.
- * @param [out] overhead_time_ptr  Pointer to the profiling overhead time
- *                                 incurred by calling children of this region.
+ * @brief  Sets the filter for regions met from now on.
+ * @param [in] region_filter  The filter, which must outlive the table.
+ *
  */
 
-void meto::HashTable::add_child_time_to_parent(
-    record_index_t const parent_index, time_duration_t const child_walltime,
-    time_duration_t *&overhead_time_ptr) {
-  auto &record = hashvec_[parent_index];
-  record.child_walltime_ += child_walltime;
-  overhead_time_ptr = &record.overhead_walltime_;
+void meto::HashTable::set_region_filter(RegionFilter const &region_filter) {
+  region_filter_ = &region_filter;
 }
 
 /**
- * @brief Increment the number of calls to the profiler callipers. Also returns
- *        a pointer to the total profiling overhead time so that it can be
- *        incremented downstream, outside this function, with minimal
- *        additional overhead.
- * @param [out] overhead_time_ptr  Pointer to the total profiling overhead time
- *                                 incurred by calling every set of profiler
- *                                 calls.
+ * @brief  Sets the maximum number of region records, beyond which new region
+ *         names are folded into an overflow record.
+ * @param [in] max_regions  The maximum, not counting the profiler's own
+ *                          record.
+ *
+ */
+
+void meto::HashTable::set_max_regions(std::size_t const max_regions) {
+  max_regions_ = max_regions;
+}
+
+/**
+ * @brief  Sets the number of warm-up calls of each region.
+ * @param [in] warmup_calls  The number of calls of each region that are taken
+ *                           out of its times, and reported separately.
+ *
  */
 
-void meto::HashTable::add_profiler_call(time_duration_t *&overhead_time_ptr) {
-  auto &record = hashvec_[profiler_index_];
-  ++record.call_count_;
-  overhead_time_ptr = &record.total_walltime_;
+void meto::HashTable::set_warmup_calls(
+    unsigned long long int const warmup_calls) {
+  warmup_calls_ = warmup_calls;
+  warmup_ = true;
+}
+
+/**
+ * @brief  Profiles regions by call path from now on, with a record for each
+ *         node of the call tree.
+ *
+ */
+
+void meto::HashTable::set_call_tree() { call_tree_ = true; }
+
+/**
+ * @brief  Marks the steady state for every region that has not yet reached
+ *         it. All their calls so far are warm-up calls.
+ * @note   Regions met from now on have no warm-up calls.
+ *
+ */
+
+void meto::HashTable::mark_steady_state() {
+  for (auto &record : hashvec_) {
+    if (!record.warmed_up_ && record.region_hash_ != profiler_hash_) {
+      end_warmup(record);
+    }
+  }
+  warmup_calls_ = 0;
+  warmup_ = true;
+}
+
+/**
+ * @brief  Records the times and counts of a region on reaching a steady
+ *         state. Everything accrued so far is warm-up.
+ * @param [inout] record  The region record.
+ *
+ */
+
+void meto::HashTable::end_warmup(RegionRecord &record) {
+  record.warmup_.total_walltime_ = record.total_walltime_;
+  record.warmup_.recursion_total_walltime_ = record.recursion_total_walltime_;
+  record.warmup_.child_walltime_ = record.child_walltime_;
+  record.warmup_.overhead_walltime_ = record.overhead_walltime_;
+  record.warmup_.call_count_ = record.call_count_;
+  record.warmup_.nested_call_count_ = record.nested_call_count_;
+  record.warmup_.child_call_count_ = record.child_call_count_;
+  record.warmup_.untimed_call_count_ = record.untimed_call_count_;
+  record.warmed_up_ = true;
+}
+
+/**
+ * @brief  Takes the warm-up times and counts out of a copy of a region
+ *         record, which is to be written.
+ * @param [inout] record  The copy of the region record.
+ * @note   A region that has not had its warm-up calls by the time the profile
+ *         is written has only warm-up calls.
+ */
+
+void meto::HashTable::split_warmup(RegionRecord &record) {
+
+  // The profiler's own record holds only overheads.
+  if (record.region_hash_ == profiler_hash_) {
+    return;
+  }
+
+  if (!record.warmed_up_ && warmup_calls_ > 0) {
+    end_warmup(record);
+  }
+
+  auto const &warmup = record.warmup_;
+  record.total_walltime_ -= warmup.total_walltime_;
+  record.recursion_total_walltime_ -= warmup.recursion_total_walltime_;
+  record.child_walltime_ -= warmup.child_walltime_;
+  record.overhead_walltime_ -= warmup.overhead_walltime_;
+  record.call_count_ -= warmup.call_count_;
+  record.nested_call_count_ -= warmup.nested_call_count_;
+  record.child_call_count_ -= warmup.child_call_count_;
+  record.untimed_call_count_ -= warmup.untimed_call_count_;
+  prepare_computed_times(record);
+}
+
+/**
+ * @brief  Adds the names folded into the overflow records to a bitmap.
+ * @param [inout] overflow_names  Bitmap of folded names, of
+ *                                PROF_OVERFLOW_BITMAP_WORDS words, to which
+ *                                this table's names are added.
+ *
+ */
+
+void meto::HashTable::merge_overflow_names(
+    std::vector<std::uint64_t> &overflow_names) const {
+  for (std::size_t i = 0; i < overflow_names_.size(); ++i) {
+    overflow_names[i] |= overflow_names_[i];
+  }
+}
+
+/**
+ * @brief  Whether the region with a given hash is filtered out.
+ * @param [in] hash  The hash of the region name.
+ * @returns  True if the region has been met on this thread and filtered out.
+ *
+ */
+
+bool meto::HashTable::find_filtered(size_t const hash) const {
+  record_index_t record_index = 0;
+  return lookup_table_.find(hash, record_index) &&
+         hashvec_[record_index].filtered_;
 }
 
 /**
@@ -238,10 +493,47 @@ void meto::HashTable::sort_records() {
 
 void meto::HashTable::prepare_computed_times(RegionRecord &record) {
 
-  // Self time
-  record.self_walltime_ = record.total_walltime_ +
-                          record.recursion_total_walltime_ -
-                          record.child_walltime_ - record.overhead_walltime_;
+  // Self time. Estimated child times may exceed the time actually spent in
+  // the children, so the self time is kept from going negative.
+  record.self_walltime_ = std::max(
+      time_duration_t{0}, record.total_walltime_ +
+                              record.recursion_total_walltime_ -
+                              record.child_walltime_ -
+                              record.overhead_walltime_);
+}
+
+/**
+ * @brief   Removes the estimated cost of calliper pairs from a region's times.
+ * @details The cost of every calliper pair nested in the region is removed
+ *          from the total time. The part of each of the region's own calliper
+ *          pairs that falls inside its measured time is removed from both the
+ *          total and self times, as is the part of each direct child's pairs
+ *          that is not otherwise accounted for.
+ *
+ * @param [inout] record  The region record to compensate.
+ * @param [in]    costs   The calliper costs calibrated by init().
+ */
+
+void meto::HashTable::compensate(RegionRecord &record,
+                                 CalliperCosts const &costs) const {
+
+  // The profiler's own record already holds only overheads.
+  if (record.region_hash_ == profiler_hash_) {
+    return;
+  }
+
+  auto const own_cost = static_cast<time_duration_t>(std::llround(
+      static_cast<double>(record.call_count_) * costs.region_cost_));
+  auto const nested_cost = static_cast<time_duration_t>(std::llround(
+      static_cast<double>(record.nested_call_count_) * costs.pair_cost_));
+
+  auto const gap_cost = static_cast<time_duration_t>(std::llround(
+      static_cast<double>(record.child_call_count_) * costs.gap_cost_));
+
+  record.total_walltime_ = std::max(
+      time_duration_t{0}, record.total_walltime_ - own_cost - nested_cost);
+  record.self_walltime_ = std::max(time_duration_t{0},
+                                   record.self_walltime_ - own_cost - gap_cost);
 }
 
 /**
@@ -252,8 +544,8 @@ void meto::HashTable::prepare_computed_times(RegionRecord &record) {
 void meto::HashTable::prepare_computed_times_all() {
 
   // Loop over entries in the hashtable.
-  for (auto &[hash, index] : lookup_table_) {
-    prepare_computed_times(hash2record(hash));
+  for (auto const &[hash, index] : lookup_table_) {
+    prepare_computed_times(hashvec_[index]);
   }
 }
 
@@ -264,8 +556,8 @@ void meto::HashTable::prepare_computed_times_all() {
 
 std::vector<size_t> meto::HashTable::list_keys() {
   std::vector<size_t> keys;
-  for (auto const &key : lookup_table_) {
-    keys.push_back(key.first);
+  for (auto const &[hash, index] : lookup_table_) {
+    keys.push_back(hash);
   }
   return keys;
 }
@@ -274,16 +566,19 @@ std::vector<size_t> meto::HashTable::list_keys() {
  * @brief  Appends table_ onto the end of an input hashvec.
  * @param[inout] hashvec_handler  HashVecHandler object containing the
  *                                hashvec to amend.
+ * @param[in]    compensation     Calibrated calliper costs to remove from the
+ *                                appended times. None are removed by default.
  *
  */
 
-void meto::HashTable::append_to(HashVecHandler &hashvec_handler) {
+void meto::HashTable::append_to(HashVecHandler &hashvec_handler,
+                                CalliperCosts const &compensation) {
   // Compute overhead and self times before appending
   prepare_computed_times_all();
 
   // Loop over entries in the hashtable.
-  for (auto &[hash, index] : lookup_table_) {
-    prepare_computed_times(hash2record(hash));
+  for (auto const &[hash, index] : lookup_table_) {
+    prepare_computed_times(hashvec_[index]);
   }
 
   // Erase profiler entry if call count is zero.
@@ -294,8 +589,34 @@ void meto::HashTable::append_to(HashVecHandler &hashvec_handler) {
   // Sync-up the lookup table and hashvec.
   sync_lookup();
 
-  // Append hashvec to that passed through the argument list.
-  hashvec_handler.append(hashvec_);
+  // Append hashvec to that passed through the argument list. Filtered regions
+  // are left out, as are the records of regions met only below the top of the
+  // call tree. Warm-up calls and compensation are taken out of a copy, so that
+  // the stored times are left as measured.
+  bool const compensating =
+      compensation.pair_cost_ > 0.0 || compensation.region_cost_ > 0.0;
+  if (compensating || region_filter_ || warmup_ || call_tree_) {
+    hashvec_t output_hashvec;
+    output_hashvec.reserve(hashvec_.size());
+    for (auto const &record : hashvec_) {
+      if (record.filtered_) {
+        continue;
+      }
+      if (call_tree_ && record.call_count_ == 0 && record.event_count_ == 0) {
+        continue;
+      }
+      output_hashvec.push_back(record);
+      if (warmup_) {
+        split_warmup(output_hashvec.back());
+      }
+      if (compensating) {
+        compensate(output_hashvec.back(), compensation);
+      }
+    }
+    hashvec_handler.append(output_hashvec);
+  } else {
+    hashvec_handler.append(hashvec_);
+  }
 }
 
 /**
@@ -306,8 +627,7 @@ void meto::HashTable::append_to(HashVecHandler &hashvec_handler) {
 
 void meto::HashTable::erase_record(size_t const hash) {
 
-  // Find the lookup table (hashtable) iterator.
-  auto iterator = lookup_table_.find(hash);
+  // Find the record index.
   auto const index = lookup_table_.at(hash);
 
   // Get the hashvec iterator from the index
@@ -316,7 +636,7 @@ void meto::HashTable::erase_record(size_t const hash) {
 
   // Erase from both the hashvec and the lookup table.
   hashvec_.erase(record_iterator);
-  lookup_table_.erase(iterator);
+  lookup_table_.erase(hash);
 }
 
 /**
@@ -329,9 +649,15 @@ void meto::HashTable::sync_lookup() {
   // as a result of the erase().
   for (auto it = begin(hashvec_); it != end(hashvec_); ++it) {
     auto current_index = it - hashvec_.begin();
-    lookup_table_[it->region_hash_] =
-        static_cast<record_index_t>(current_index);
+    lookup_table_.insert_or_assign(it->region_hash_,
+                                   static_cast<record_index_t>(current_index));
   }
+
+  // Resolved handles, cached names and cached child nodes point at the old
+  // indices. They are re-resolved lazily.
+  handle_lookup_.clear();
+  name_cache_.fill(NameCacheEntry{});
+  child_caches_.clear();
 }
 
 /**
@@ -344,7 +670,7 @@ void meto::HashTable::sync_lookup() {
 double meto::HashTable::get_total_walltime(size_t const hash) const {
   auto &record = hash2record(hash);
 
-  return record.total_walltime_.count();
+  return ticks_to_seconds(record.total_walltime_);
 }
 
 /**
@@ -355,7 +681,7 @@ double meto::HashTable::get_total_walltime(size_t const hash) const {
 
 double meto::HashTable::get_overhead_walltime(size_t const hash) const {
   auto &record = hash2record(hash);
-  return record.overhead_walltime_.count();
+  return ticks_to_seconds(record.overhead_walltime_);
 }
 
 /**
@@ -369,7 +695,13 @@ double meto::HashTable::get_overhead_walltime(size_t const hash) const {
 double meto::HashTable::get_self_walltime(size_t const hash) {
   auto &record = hash2record(hash);
   prepare_computed_times(record);
-  return record.self_walltime_.count();
+
+  // Combine the component times in seconds, so that the result is consistent
+  // with the values returned by the other getters.
+  return std::max(0.0, ticks_to_seconds(record.total_walltime_) +
+                           ticks_to_seconds(record.recursion_total_walltime_) -
+                           ticks_to_seconds(record.child_walltime_) -
+                           ticks_to_seconds(record.overhead_walltime_));
 }
 
 /**
@@ -381,7 +713,7 @@ double meto::HashTable::get_self_walltime(size_t const hash) {
 
 double meto::HashTable::get_child_walltime(size_t const hash) const {
   auto &record = hash2record(hash);
-  return record.child_walltime_.count();
+  return ticks_to_seconds(record.child_walltime_);
 }
 
 /**
@@ -411,6 +743,22 @@ meto::HashTable::get_call_count(size_t const hash) const {
   return record.call_count_;
 }
 
+/**
+ * @brief  Get the number of events counted for the input hash region.
+ *
+ * @param[in] hash  The hash corresponding to the region of interest.
+ *
+ * @returns  Returns the total of the counts passed to Vernier::count for the
+ *           region.
+ *
+ */
+
+unsigned long long int
+meto::HashTable::get_event_count(size_t const hash) const {
+  auto &record = hash2record(hash);
+  return record.event_count_;
+}
+
 /**
  * @brief  Get the number of calliper pairs called.
  *
@@ -421,7 +769,7 @@ meto::HashTable::get_call_count(size_t const hash) const {
 
 unsigned long long int meto::HashTable::get_prof_call_count() const {
   auto &record = hash2record(profiler_hash_);
-  assert(lookup_table_.count(profiler_hash_) > 0);
+  assert(lookup_table_.contains(profiler_hash_));
   return record.call_count_;
 }
 
@@ -23,15 +23,38 @@
 #ifndef VERNIER_HASHTABLE_H
 #define VERNIER_HASHTABLE_H
 
-#include <unordered_map>
+#include <array>
+#include <cstdint>
 
+#include "flat_lookup_table.h"
 #include "hashvec.h"
+#include "region_filter.h"
+#include "region_registry.h"
+#include "sample_rates.h"
 #include "vernier_gettime.h"
 
 #define PROF_HASHVEC_RESERVE_SIZE 1000
-#ifndef PROF_STRING_BUFFER_LENGTH
-#define PROF_STRING_BUFFER_LENGTH 100
-#endif
+
+// Records into which region names beyond the region limit are folded, for
+// names that are profiled and names that are filtered out.
+#define PROF_OVERFLOW_REGION "__overflow__"
+#define PROF_FILTERED_OVERFLOW_REGION "__overflow_filtered__"
+
+// Size of the bitmap used to count the distinct names folded into the
+// overflow records, in 64-bit words.
+#define PROF_OVERFLOW_BITMAP_WORDS 1024
+
+// Separator between the regions of a call path, in call-tree mode.
+#define PROF_CALL_PATH_SEPARATOR '/'
+
+// Number of entries in the child cache of each call-tree node. Must be a power
+// of two. Not overridable, since the inline callipers index the cache.
+#define PROF_CHILD_CACHE_SIZE 4
+
+// Number of entries in the region name cache. Must be a power of two. Not
+// overridable, since it sets the layout of HashTable, which client code
+// compiles against.
+#define PROF_NAME_CACHE_SIZE 64
 
 namespace meto {
 
@@ -39,20 +62,25 @@ namespace meto {
 class HashVecHandler;
 
 /**
- * @brief  Defines a null hash function.
+ * @brief  Calibrated cost of a calliper pair, in clock ticks.
  *
- * Having already hashed region names, we won't need to hash the hashtable keys.
+ * The pair cost is the time that an empty region adds to its parent. Of that,
+ * the region cost falls inside the empty region's own measured time, and the
+ * gap cost is neither in the region's time nor in the overhead charged to the
+ * parent, so it ends up in the parent's self time.
  *
  */
 
-struct NullHashFunction {
-  std::size_t operator()(std::size_t const &key) const { return key; }
+struct CalliperCosts {
+  double pair_cost_ = 0.0;
+  double region_cost_ = 0.0;
+  double gap_cost_ = 0.0;
 };
 
 /**
- * @brief  Wraps STL hashtables with additional functionality.
+ * @brief  Wraps a lookup table with additional functionality.
  *
- * Bundles together an STL hashtable with the hashing algorithm, and adds
+ * Bundles together a flat lookup table with the hashing algorithm, and adds
  * e.g. time-handling methods.
  *
  */
@@ -65,44 +93,152 @@ class HashTable {
   size_t profiler_hash_;
   record_index_t profiler_index_;
 
-  // Hash function
-  std::hash<std::string_view> hash_function_;
-
   // Hashtable containing locations of region records.
-  std::unordered_map<size_t, record_index_t, NullHashFunction> lookup_table_;
+  FlatLookupTable lookup_table_;
 
   // Vector of region records.
   hashvec_t hashvec_;
 
+  // Sample rates for new region records. Null if every call is timed.
+  SampleRates const *sample_rates_ = nullptr;
+
+  // Regions called at least throttle_calls_ times, for less than
+  // throttle_ticks_ per call on average, are no longer timed. Zero calls
+  // disables throttling.
+  unsigned long long int throttle_calls_ = 0;
+  double throttle_ticks_ = 0.0;
+
+  // Filter for new region records. Null if no region is filtered out.
+  RegionFilter const *region_filter_ = nullptr;
+
+  // Maximum number of region records, not counting the profiler's own. Names
+  // met once the limit is reached are folded into an overflow record. Zero
+  // means no limit.
+  std::size_t max_regions_ = 0;
+
+  // Bitmap of the hashes of names folded into the overflow records, from
+  // which the number of distinct names is estimated. Empty until a name is
+  // first folded.
+  std::vector<std::uint64_t> overflow_names_;
+
+  // Number of warm-up calls of each region. A region reaches a steady state
+  // once this many calls have stopped. Zero means that regions only reach a
+  // steady state when it is marked.
+  unsigned long long int warmup_calls_ = 0;
+
+  // Whether warm-up calls are taken out of the times written.
+  bool warmup_ = false;
+
+  // Region record indices, indexed by region handle ID. Unresolved handles
+  // hold handle_unset_.
+  std::vector<record_index_t> handle_lookup_;
+  static constexpr record_index_t handle_unset_ = ~record_index_t{0};
+
+  /**
+   * @brief  Region name cache entry, keyed on the address and length of the
+   *         name passed to the start calliper.
+   * @details The record is that of the name, or for an indexed start that of
+   *          one of the name's indexed regions. Either way, the hash is that
+   *          of the name alone.
+   */
+
+  struct NameCacheEntry {
+    char const *name_ = nullptr;
+    std::size_t length_ = 0;
+    record_index_t record_index_ = 0;
+    size_t name_hash_ = 0;
+  };
+
+  // Direct-mapped cache of recently started region names. Callers usually
+  // pass the same string literal for a given region, so a hit avoids
+  // hashing the name.
+  std::array<NameCacheEntry, PROF_NAME_CACHE_SIZE> name_cache_{};
+  static_assert((PROF_NAME_CACHE_SIZE & (PROF_NAME_CACHE_SIZE - 1)) == 0,
+                "PROF_NAME_CACHE_SIZE must be a power of two.");
+
+  // Whether regions are profiled by call path, with a record for each node of
+  // the call tree below the top level. Region records found by name are then
+  // the nodes at the top of the tree.
+  bool call_tree_ = false;
+
+  /**
+   * @brief  Child cache entry, mapping a region record to the call-tree node
+   *         for that region beneath a given parent node.
+   */
+
+  struct ChildCacheEntry {
+    record_index_t region_index_ = ~record_index_t{0};
+    record_index_t node_index_ = 0;
+  };
+
+  // Direct-mapped caches of the children of each call-tree node, indexed by
+  // the parent's record index, then by the child's region record index.
+  // Grown as nodes are met. A hit avoids hashing the call path.
+  using ChildCache = std::array<ChildCacheEntry, PROF_CHILD_CACHE_SIZE>;
+  std::vector<ChildCache> child_caches_;
+  static_assert((PROF_CHILD_CACHE_SIZE & (PROF_CHILD_CACHE_SIZE - 1)) == 0,
+                "PROF_CHILD_CACHE_SIZE must be a power of two.");
+
   // Private member functions
+  record_index_t insert_node(record_index_t const, record_index_t const);
+  void fold_overflow(std::string_view const, size_t &, record_index_t &);
+  void end_warmup(RegionRecord &);
+  void split_warmup(RegionRecord &);
   void prepare_computed_times(RegionRecord &);
+  void compensate(RegionRecord &, CalliperCosts const &) const;
   void prepare_computed_times_all();
   void sort_records();
   void erase_record(size_t const);
   void sync_lookup();
+  NameCacheEntry &name_cache_entry(std::string_view const);
   RegionRecord &hash2record(size_t const);
   RegionRecord const &hash2record(size_t const) const;
 
 public:
   // Constructors
   HashTable() = delete;
-  HashTable(int);
+  HashTable(int, std::size_t const = PROF_HASHVEC_RESERVE_SIZE);
 
-  // Prototypes
-  size_t compute_hash(std::string_view, int);
+  // Prototypes. Methods called by the callipers are defined inline in
+  // vernier_inline.h.
+  size_t compute_hash(std::string_view const);
   void query_insert(std::string_view const, int, size_t &,
                     record_index_t &) noexcept;
-  void update(record_index_t const, time_duration_t const);
+  void query_insert_indexed(std::string_view const, int const, int, size_t &,
+                            record_index_t &) noexcept;
+  void update(record_index_t const, time_duration_t const,
+              unsigned long long int const);
+  void add_events(record_index_t const, unsigned long long int const);
+  bool time_call(record_index_t const);
+  time_duration_t update_untimed(record_index_t const,
+                                 unsigned long long int const);
+  void throttle(record_index_t const);
+  void set_sample_rates(SampleRates const &);
+  void set_throttle(unsigned long long int const, double const);
+  void set_region_filter(RegionFilter const &);
+  bool is_filtered(record_index_t const) const;
+  bool find_filtered(size_t const) const;
+  void set_max_regions(std::size_t const);
+  void merge_overflow_names(std::vector<std::uint64_t> &) const;
+  void set_warmup_calls(unsigned long long int const);
+  void set_call_tree();
+  record_index_t query_node(record_index_t const, record_index_t const);
+  void mark_steady_state();
+
+  // Region handles
+  bool query_handle(RegionHandle const, size_t &, record_index_t &) const;
+  void insert_handle(RegionHandle const, record_index_t const);
 
   // Member functions
   std::vector<size_t> list_keys();
 
   void add_child_time_to_parent(record_index_t const, time_duration_t const,
                                 time_duration_t *&);
+  void mark_estimated_child_time(record_index_t const);
   void add_profiler_call(time_duration_t *&);
 
   void compute_self_times();
-  void append_to(HashVecHandler &);
+  void append_to(HashVecHandler &, CalliperCosts const & = {});
 
   // Getters
   double get_total_walltime(size_t const hash) const;
@@ -111,6 +247,7 @@ class HashTable {
   double get_child_walltime(size_t const hash) const;
   std::string get_decorated_region_name(size_t const hash) const;
   unsigned long long int get_call_count(size_t const hash) const;
+  unsigned long long int get_event_count(size_t const hash) const;
   unsigned long long int get_prof_call_count() const;
 
   void increment_recursion_level(record_index_t const);
@@ -16,12 +16,16 @@
 meto::RegionRecord::RegionRecord(size_t const region_hash,
                                  std::string_view const region_name, int tid)
     : region_hash_(region_hash), region_name_(region_name),
-      total_walltime_(time_duration_t::zero()),
-      recursion_total_walltime_(time_duration_t::zero()),
-      self_walltime_(time_duration_t::zero()),
-      child_walltime_(time_duration_t::zero()),
-      overhead_walltime_(time_duration_t::zero()), call_count_(0),
-      recursion_level_(0) {
+      total_walltime_(0),
+      recursion_total_walltime_(0),
+      self_walltime_(0),
+      child_walltime_(0),
+      overhead_walltime_(0), call_count_(0), event_count_(0),
+      nested_call_count_(0),
+      child_call_count_(0), recursion_level_(0), sample_rate_(1),
+      sample_countdown_(0), last_walltime_(0), untimed_call_count_(0),
+      estimated_child_time_(false), throttled_(false), filtered_(false),
+      warmed_up_(false) {
   decorated_region_name_ = region_name_;
   decorated_region_name_ += '@';
   decorated_region_name_ += std::to_string(tid);
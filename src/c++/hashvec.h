@@ -17,6 +17,7 @@
 #include <string_view>
 #include <vector>
 
+#include "sample_rates.h"
 #include "vernier_gettime.h"
 
 namespace meto {
@@ -28,6 +29,22 @@ namespace meto {
  *
  */
 
+/**
+ * @brief  Times and counts accrued by a region while warming up, before it
+ *         reached a steady state.
+ */
+
+struct WarmupTimes {
+  time_duration_t total_walltime_ = 0;
+  time_duration_t recursion_total_walltime_ = 0;
+  time_duration_t child_walltime_ = 0;
+  time_duration_t overhead_walltime_ = 0;
+  unsigned long long int call_count_ = 0;
+  unsigned long long int nested_call_count_ = 0;
+  unsigned long long int child_call_count_ = 0;
+  unsigned long long int untimed_call_count_ = 0;
+};
+
 struct RegionRecord {
 public:
   // Constructor
@@ -44,7 +61,32 @@ struct RegionRecord {
   time_duration_t child_walltime_;
   time_duration_t overhead_walltime_;
   unsigned long long int call_count_;
+  unsigned long long int event_count_;
+  unsigned long long int nested_call_count_;
+  unsigned long long int child_call_count_;
   unsigned int recursion_level_;
+
+  // Sampling. Calls that are not timed are charged the duration of the most
+  // recent call.
+  sample_rate_t sample_rate_;
+  sample_rate_t sample_countdown_;
+  time_duration_t last_walltime_;
+  unsigned long long int untimed_call_count_;
+
+  // Set once an untimed child call has charged the region an estimated child
+  // time, so that its self time is also an estimate.
+  bool estimated_child_time_;
+
+  // Set once the region is no longer timed. Later calls are only counted.
+  bool throttled_;
+
+  // Set if the region is filtered out. Its calls are ignored.
+  bool filtered_;
+
+  // Warm-up. The times and counts when the region reached a steady state,
+  // which are taken out of the other times when the profile is written.
+  WarmupTimes warmup_;
+  bool warmed_up_;
 };
 
 // Define the hashvec type.
@@ -60,7 +60,10 @@ void meto::HashVecHandler::sort() {
 
 /**
  * @brief  Calls the writer strategy.
+ * @param [in] notes  Notes on how the profile was taken, for the output.
  *
  */
 
-void meto::HashVecHandler::write() { writer_strategy_->write(hashvec_); }
+void meto::HashVecHandler::write(profile_notes_t const &notes) {
+  writer_strategy_->write(hashvec_, notes);
+}
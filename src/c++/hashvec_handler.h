@@ -50,7 +50,7 @@ class HashVecHandler {
 
   // Member functions
   void sort();
-  void write();
+  void write(profile_notes_t const &notes = {});
   void append(hashvec_t const &);
 };
 
@@ -0,0 +1,180 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include "region_filter.h"
+#include "error_handler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fnmatch.h>
+#include <fstream>
+
+namespace {
+
+/**
+ * @brief  Splits a comma-separated list of patterns.
+ * @param [in]    list      The list.
+ * @param [inout] patterns  The patterns, to which those in the list are added.
+ */
+
+void split_patterns(std::string_view list,
+                    std::vector<std::string> &patterns) {
+  while (!list.empty()) {
+    auto const comma = list.find(',');
+    auto const pattern = list.substr(0, comma);
+    list = comma == std::string_view::npos ? std::string_view{}
+                                           : list.substr(comma + 1);
+    if (!pattern.empty()) {
+      patterns.emplace_back(pattern);
+    }
+  }
+}
+
+/**
+ * @brief  Whether a region name matches any of a list of patterns.
+ * @param [in] region_name  The region name.
+ * @param [in] patterns     The glob patterns.
+ */
+
+bool matches_any(std::string const &region_name,
+                 std::vector<std::string> const &patterns) {
+  return std::any_of(patterns.begin(), patterns.end(),
+                     [&region_name](std::string const &pattern) {
+                       return fnmatch(pattern.c_str(), region_name.c_str(),
+                                      0) == 0;
+                     });
+}
+
+} // namespace
+
+/**
+ * @brief  Adds include patterns.
+ * @param [in] list  A comma-separated list of glob patterns.
+ *
+ */
+
+void meto::RegionFilter::add_include_patterns(std::string_view const list) {
+  split_patterns(list, include_patterns_);
+}
+
+/**
+ * @brief  Adds exclude patterns.
+ * @param [in] list  A comma-separated list of glob patterns.
+ *
+ */
+
+void meto::RegionFilter::add_exclude_patterns(std::string_view const list) {
+  split_patterns(list, exclude_patterns_);
+}
+
+/**
+ * @brief  Reads patterns from a filter file.
+ * @param [in] filename  The file name.
+ * @details Each line holds "include" or "exclude", then a glob pattern, or
+ *          "regions", then the number of regions expected. Blank lines and
+ *          lines starting with '#' are ignored.
+ *
+ */
+
+void meto::RegionFilter::read_file(std::string const &filename) {
+  std::ifstream file(filename);
+  if (!file) {
+    error_handler("Vernier: cannot open filter file '" + filename + "'.",
+                  EXIT_FAILURE);
+  }
+
+  std::string line;
+  while (std::getline(file, line)) {
+    auto const first = line.find_first_not_of(" \t");
+    if (first == std::string::npos || line[first] == '#') {
+      continue;
+    }
+
+    auto const keyword_end = line.find_first_of(" \t", first);
+    auto const pattern_start = line.find_first_not_of(" \t", keyword_end);
+    auto const pattern_end = line.find_last_not_of(" \t\r");
+    auto const keyword = line.substr(first, keyword_end - first);
+    if (pattern_start == std::string::npos ||
+        (keyword != "include" && keyword != "exclude" &&
+         keyword != "regions")) {
+      error_handler("Invalid line in filter file '" + filename +
+                        "'. Expected 'include <pattern>', "
+                        "'exclude <pattern>' or 'regions <count>', but "
+                        "found '" +
+                        line + "'.",
+                    EXIT_FAILURE);
+    }
+
+    if (keyword == "regions") {
+      char const *const count_start = line.c_str() + pattern_start;
+      char *end = nullptr;
+      auto const count = std::strtoull(count_start, &end, 10);
+      if (end == count_start || end != line.c_str() + pattern_end + 1 ||
+          *count_start == '-') {
+        error_handler("Invalid region count in filter file '" + filename +
+                          "'. Expected a non-negative integer, but found '" +
+                          line + "'.",
+                      EXIT_FAILURE);
+      }
+      expected_regions_ = static_cast<std::size_t>(count);
+      continue;
+    }
+
+    auto pattern = line.substr(pattern_start, pattern_end - pattern_start + 1);
+    if (keyword == "include") {
+      include_patterns_.push_back(std::move(pattern));
+    } else {
+      exclude_patterns_.push_back(std::move(pattern));
+    }
+  }
+}
+
+/**
+ * @brief  Removes all patterns, so that no region is filtered out, and the
+ *         expected number of regions.
+ *
+ */
+
+void meto::RegionFilter::clear() {
+  include_patterns_.clear();
+  exclude_patterns_.clear();
+  expected_regions_ = 0;
+}
+
+/**
+ * @brief  Whether any patterns have been given.
+ *
+ */
+
+bool meto::RegionFilter::is_active() const {
+  return !include_patterns_.empty() || !exclude_patterns_.empty();
+}
+
+/**
+ * @brief  Whether a region is filtered out.
+ * @param [in] region_name  The region name.
+ * @returns  True if the region matches an exclude pattern, or if there are
+ *           include patterns and it matches none of them.
+ *
+ */
+
+bool meto::RegionFilter::is_filtered(std::string_view const region_name) const {
+  std::string const name(region_name);
+  if (matches_any(name, exclude_patterns_)) {
+    return true;
+  }
+  return !include_patterns_.empty() && !matches_any(name, include_patterns_);
+}
+
+/**
+ * @brief  The number of regions expected, from a filter file.
+ * @returns  The number of regions, or 0 if no filter file gave it.
+ *
+ */
+
+std::size_t meto::RegionFilter::get_expected_regions() const {
+  return expected_regions_;
+}
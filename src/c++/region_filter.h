@@ -0,0 +1,57 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+/**
+ *  @file   region_filter.h
+ *  @brief  Include and exclude filters on region names.
+ *
+ *  Filters are glob patterns, as understood by fnmatch(3). A region is
+ *  filtered out if it matches any exclude pattern, or if there are include
+ *  patterns and it matches none of them. Each region name is tested once, when
+ *  its record is created.
+ *
+ *  Filter files may also give the number of regions expected, as written by
+ *  the vernier-manifest tool, so that space for them can be reserved.
+ *
+ */
+
+#ifndef VERNIER_REGION_FILTER_H
+#define VERNIER_REGION_FILTER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace meto {
+
+/**
+ * @brief  Include and exclude patterns for region names.
+ */
+
+class RegionFilter {
+
+private:
+  std::vector<std::string> include_patterns_;
+  std::vector<std::string> exclude_patterns_;
+  std::size_t expected_regions_ = 0;
+
+public:
+  // Member functions
+  void add_include_patterns(std::string_view const);
+  void add_exclude_patterns(std::string_view const);
+  void read_file(std::string const &);
+  void clear();
+
+  // Getters
+  bool is_active() const;
+  bool is_filtered(std::string_view const) const;
+  std::size_t get_expected_regions() const;
+};
+
+} // namespace meto
+
+#endif
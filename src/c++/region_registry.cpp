@@ -0,0 +1,61 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include "region_registry.h"
+#include "error_handler.h"
+
+#include <cassert>
+
+/**
+ * @brief  Registers a region name, if not already registered.
+ * @param [in] region_name  The region name.
+ * @param [in] hash         Hash of the region name, from hash_region_name.
+ * @returns  The handle for the region name. Registering the same name more
+ *           than once returns the same handle.
+ *
+ */
+
+meto::RegionHandle
+meto::RegionRegistry::insert(std::string_view const region_name,
+                             std::size_t const hash) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (auto search = ids_.find(hash); search != ids_.end()) {
+    if (names_[search->second] != region_name) {
+      error_handler("Vernier::RegionRegistry. Region name hash collision "
+                    "between '" +
+                        names_[search->second] + "' and '" +
+                        std::string(region_name) + "'.",
+                    EXIT_FAILURE);
+    }
+    return RegionHandle(search->second);
+  }
+
+  region_id_t const id = names_.size();
+  names_.emplace_back(region_name);
+  ids_.emplace(hash, id);
+
+  assert(names_.size() == ids_.size());
+  return RegionHandle(id);
+}
+
+/**
+ * @brief  Gets the region name corresponding to a handle.
+ * @param [in] handle  The region handle.
+ * @returns  A copy of the region name, since the caller does not hold the lock.
+ *
+ */
+
+std::string meto::RegionRegistry::get_name(RegionHandle const handle) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (handle.id_ >= names_.size()) {
+    error_handler("Vernier::RegionRegistry. Invalid region handle.",
+                  EXIT_FAILURE);
+  }
+
+  return names_[handle.id_];
+}
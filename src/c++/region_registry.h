@@ -0,0 +1,87 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+/**
+ *  @file   region_registry.h
+ *  @brief  Registry of region names that have been resolved into handles.
+ *
+ *  Region handles are resolved once, from a region name, and are the same on
+ *  every thread. Each per-thread hashtable maps handles onto its own region
+ *  records the first time a handle is used on that thread.
+ *
+ */
+
+#ifndef VERNIER_REGION_REGISTRY_H
+#define VERNIER_REGION_REGISTRY_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace meto {
+
+// Type definitions
+using region_id_t = std::size_t;
+
+/**
+ * @brief  A pre-registered region handle.
+ *
+ * Thread-independent identifier for a region name, returned by
+ * Vernier::register_region.
+ *
+ */
+
+struct RegionHandle {
+public:
+  // Constructors
+  RegionHandle() = delete;
+  explicit RegionHandle(region_id_t const id) : id_(id) {}
+
+  // Data members
+  region_id_t id_;
+
+  // ID of the handle returned while profiling is disabled, which is never
+  // registered.
+  static constexpr region_id_t unregistered_ = ~region_id_t{0};
+};
+
+// Handle returned for every region while profiling is disabled.
+inline RegionHandle const unregistered_region_handle{
+    RegionHandle::unregistered_};
+
+/**
+ * @brief  Thread-safe registry of region names.
+ *
+ * Assigns each distinct region name a small integer ID, suitable for direct
+ * indexing. Names are looked up by hash, which the caller supplies so that it
+ * can be computed at compile time where possible.
+ *
+ */
+
+class RegionRegistry {
+
+private:
+  // Guards all data members below.
+  mutable std::mutex mutex_;
+
+  // Region names, indexed by region ID.
+  std::vector<std::string> names_;
+
+  // Map from region name hashes to region IDs.
+  std::unordered_map<std::size_t, region_id_t> ids_;
+
+public:
+  // Member functions
+  RegionHandle insert(std::string_view const, std::size_t const);
+  std::string get_name(RegionHandle const) const;
+};
+
+} // namespace meto
+
+#endif
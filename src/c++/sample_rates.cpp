@@ -0,0 +1,110 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include "sample_rates.h"
+#include "error_handler.h"
+#include "vernier_hash.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+/**
+ * @brief  Parses a sample rate.
+ * @param [in]  text  The rate, as text.
+ * @param [out] rate  The rate.
+ * @returns  True if the text is a positive integer.
+ */
+
+bool parse_rate(std::string_view const text, meto::sample_rate_t &rate) {
+  auto const end = text.data() + text.size();
+  auto const [ptr, ec] = std::from_chars(text.data(), end, rate);
+  return ec == std::errc() && ptr == end && rate > 0;
+}
+
+} // namespace
+
+/**
+ * @brief  Sets the sample rate for regions without an override.
+ * @param [in] setting  The value of VERNIER_SAMPLE_RATE.
+ *
+ */
+
+void meto::SampleRates::set_default_rate(std::string_view const setting) {
+  if (!parse_rate(setting, default_rate_)) {
+    error_handler("Invalid VERNIER_SAMPLE_RATE. Expected a positive integer, "
+                  "but it is set to '" +
+                      std::string(setting) + "'.",
+                  EXIT_FAILURE);
+  }
+}
+
+/**
+ * @brief  Sets sample rates for individual regions.
+ * @param [in] setting  The value of VERNIER_SAMPLE_REGIONS: a comma-separated
+ *                      list of region=rate pairs.
+ *
+ */
+
+void meto::SampleRates::set_region_rates(std::string_view setting) {
+  while (!setting.empty()) {
+    auto const comma = setting.find(',');
+    auto const entry = setting.substr(0, comma);
+    setting = comma == std::string_view::npos ? std::string_view{}
+                                              : setting.substr(comma + 1);
+
+    // Region names may contain '=', so split on the last one.
+    auto const equals = entry.rfind('=');
+    sample_rate_t rate = 0;
+    if (equals == 0 || equals == std::string_view::npos ||
+        !parse_rate(entry.substr(equals + 1), rate)) {
+      error_handler("Invalid VERNIER_SAMPLE_REGIONS. Expected a "
+                    "comma-separated list of region=rate pairs, but it "
+                    "contains '" +
+                        std::string(entry) + "'.",
+                    EXIT_FAILURE);
+    }
+    region_rates_[hash_region_name(entry.substr(0, equals))] = rate;
+  }
+}
+
+/**
+ * @brief  Resets every region to be timed on every call.
+ *
+ */
+
+void meto::SampleRates::clear() {
+  default_rate_ = 1;
+  region_rates_.clear();
+}
+
+/**
+ * @brief  Gets the sample rate for a region.
+ * @param [in] hash  Hash of the region name.
+ * @returns  The region's override, if it has one, or else the default rate.
+ *
+ */
+
+meto::sample_rate_t meto::SampleRates::get_rate(std::size_t const hash) const {
+  if (auto search = region_rates_.find(hash); search != region_rates_.end()) {
+    return search->second;
+  }
+  return default_rate_;
+}
+
+/**
+ * @brief  Whether any region is timed on fewer than all of its calls.
+ *
+ */
+
+bool meto::SampleRates::is_sampling() const {
+  return default_rate_ > 1 ||
+         std::any_of(region_rates_.begin(), region_rates_.end(),
+                     [](auto const &entry) { return entry.second > 1; });
+}
@@ -0,0 +1,58 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+/**
+ *  @file   sample_rates.h
+ *  @brief  Sample rates for timed regions.
+ *
+ *  In sampled mode, a region with sample rate N is timed on one in N of its
+ *  calls, starting with the first. Every call is still counted and placed on
+ *  the traceback. Calls that are not timed are charged the duration of the
+ *  region's most recent timed call.
+ *
+ */
+
+#ifndef VERNIER_SAMPLE_RATES_H
+#define VERNIER_SAMPLE_RATES_H
+
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+
+namespace meto {
+
+// Type definitions
+using sample_rate_t = unsigned long long int;
+
+/**
+ * @brief  Sample rates for each region.
+ *
+ * Holds a default rate, and overrides for individual regions. Overrides are
+ * keyed on the hash of the region name, so that they can be looked up when a
+ * region record is created without copying the name.
+ *
+ */
+
+class SampleRates {
+
+private:
+  sample_rate_t default_rate_ = 1;
+  std::unordered_map<std::size_t, sample_rate_t> region_rates_;
+
+public:
+  // Member functions
+  void set_default_rate(std::string_view const);
+  void set_region_rates(std::string_view const);
+  void clear();
+
+  // Getters
+  sample_rate_t get_rate(std::size_t const) const;
+  bool is_sampling() const;
+};
+
+} // namespace meto
+
+#endif
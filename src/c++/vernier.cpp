@@ -8,35 +8,95 @@
 #include "error_handler.h"
 #include "hashvec_handler.h"
 
+#include <algorithm>
+#include <bitset>
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
-// Initialize static data members.
-int meto::Vernier::call_depth_ = -1;
-meto::time_point_t meto::Vernier::logged_calliper_start_time_{};
+namespace {
 
 /**
- * @brief Constructor for TracebackEntry struct.
- * @param [in]  record_hash   The hash of the region name.
- * @param [in]  record_index  The index of the region record.
- * @param [in]  region_start_time  The clock measurement just before leaving the
- *                                 start calliper.
- * @param [in]  calliper_start_time The clock measurement on entry to the start
- *                                  calliper.
- *
+ * @brief  Describes a calibrated cost.
+ * @param [in] cost  The cost, in clock ticks.
+ * @returns  The cost in nanoseconds, for the output header.
  */
 
-meto::Vernier::TracebackEntry::TracebackEntry(
-    size_t record_hash, meto::record_index_t record_index,
-    meto::time_point_t region_start_time,
-    meto::time_point_t calliper_start_time)
-    : record_hash_(record_hash), record_index_(record_index),
-      region_start_time_(region_start_time),
-      calliper_start_time_(calliper_start_time) {}
+std::string describe_cost(double const cost) {
+  return std::to_string(
+             std::llround(cost * meto::clock_settings.seconds_per_tick_ *
+                          1.0e9)) +
+         " ns";
+}
+
+/**
+ * @brief  Describe the number of distinct region names folded into the
+ *         overflow records.
+ * @param [in] overflow_names  Bitmap of the hashes of the folded names.
+ * @returns  The number of names, estimated from the fraction of bits set.
+ * @note   This is linear counting, which is close for up to several times as
+ *         many names as there are bits.
+ */
+
+std::string
+describe_overflow(std::vector<std::uint64_t> const &overflow_names) {
+  double const bit_count = 64.0 * static_cast<double>(overflow_names.size());
+  double unset_bits = bit_count;
+  for (auto const word : overflow_names) {
+    unset_bits -= static_cast<double>(std::bitset<64>(word).count());
+  }
+
+  if (unset_bits == bit_count) {
+    return "No region names were";
+  }
+  if (unset_bits == 0.0) {
+    return "More than " +
+           std::to_string(std::llround(bit_count * std::log(bit_count))) +
+           " region names were";
+  }
+  auto const names =
+      std::llround(-bit_count * std::log(unset_bits / bit_count));
+  return "About " + std::to_string(names) + " region name" +
+         (names == 1 ? " was" : "s were");
+}
+
+} // namespace
+
+/**
+ * @brief   Read VERNIER_ENABLE and note whether profiling is enabled.
+ * @details Called by init(), and by the disabled() guard when an entry point
+ *          is reached before the variable has been read, so that callipers
+ *          called ahead of init() honour it too.
+ * @returns True if profiling is disabled.
+ */
+
+bool meto::Vernier::read_enable_setting() const {
+  auto state = EnableState::enabled;
+  char const *env_enable = std::getenv("VERNIER_ENABLE");
+  if (env_enable) {
+    std::string const enable = env_enable;
+    if (enable == "0") {
+      state = EnableState::disabled;
+    } else if (enable != "1") {
+      error_handler("Invalid VERNIER_ENABLE. Expected '0' or '1'. "
+                    "Currently set to '" +
+                        enable + "'.",
+                    EXIT_FAILURE);
+    }
+  }
+  enable_state_.store(state, std::memory_order_relaxed);
+  return state == EnableState::disabled;
+}
 
 /**
  * @brief  Initialise Vernier object.
@@ -49,33 +109,223 @@ meto::Vernier::TracebackEntry::TracebackEntry(
 void meto::Vernier::init(MPI_Comm const client_comm_handle,
                          std::string_view tag) {
 
+  // Set whether profiling is enabled. If not, nothing else is set up, and
+  // the callipers do nothing.
+  if (read_enable_setting()) {
+    ++epoch_;
+    initialized_ = true;
+    return;
+  }
+
   // Set the maximum number of threads.
   max_threads_ = 1;
 #ifdef _OPENMP
   max_threads_ = omp_get_max_threads();
 #endif
 
-  // Create vector of hash tables: one hashtable for each thread.
-  for (int tid = 0; tid < max_threads_; ++tid) {
+  // Select and calibrate the clock.
+  init_clock();
+
+  // Set the maximum traceback depth.
+  max_depth_ = PROF_MAX_TRACEBACK_SIZE;
+  char const *env_max_depth = std::getenv("VERNIER_MAX_DEPTH");
+  if (env_max_depth) {
+    char *end = nullptr;
+    long const max_depth = std::strtol(env_max_depth, &end, 10);
+    if (end == env_max_depth || *end != '\0' || max_depth < 1 ||
+        max_depth > std::numeric_limits<int>::max()) {
+      error_handler("Invalid VERNIER_MAX_DEPTH. Expected a positive integer, "
+                    "but it is set to '" +
+                        std::string(env_max_depth) + "'.",
+                    EXIT_FAILURE);
+    }
+    max_depth_ = static_cast<int>(max_depth);
+  }
 
-    // Create a new table
-    HashTable new_table(tid);
-    thread_hashtables_.push_back(new_table);
+  // Set the calliper mode.
+  calliper_mode_ = CalliperMode::full;
+  char const *env_calliper_mode = std::getenv("VERNIER_CALLIPER_MODE");
+  if (env_calliper_mode) {
+    std::string const calliper_mode = env_calliper_mode;
+    if (calliper_mode == "lean") {
+      calliper_mode_ = CalliperMode::lean;
+    } else if (calliper_mode != "full") {
+      error_handler("Invalid Vernier calliper mode. Expected 'full' or "
+                    "'lean'. Currently set to '" +
+                        calliper_mode + "'.",
+                    EXIT_FAILURE);
+    }
+  }
 
-    // Create a new list
-    std::array<TracebackEntry, PROF_MAX_TRACEBACK_SIZE> new_list;
-    thread_traceback_.push_back(new_list);
+  // Set whether output times are compensated for calliper overheads.
+  compensate_ = false;
+  char const *env_compensate = std::getenv("VERNIER_COMPENSATE");
+  if (env_compensate) {
+    std::string const compensate = env_compensate;
+    if (compensate == "1") {
+      compensate_ = true;
+    } else if (compensate != "0") {
+      error_handler("Invalid VERNIER_COMPENSATE. Expected '0' or '1'. "
+                    "Currently set to '" +
+                        compensate + "'.",
+                    EXIT_FAILURE);
+    }
+  }
+
+  // Set the sample rates.
+  sample_rates_.clear();
+  char const *env_sample_rate = std::getenv("VERNIER_SAMPLE_RATE");
+  if (env_sample_rate) {
+    sample_rates_.set_default_rate(env_sample_rate);
+  }
+  char const *env_sample_regions = std::getenv("VERNIER_SAMPLE_REGIONS");
+  if (env_sample_regions) {
+    sample_rates_.set_region_rates(env_sample_regions);
+  }
+  sampling_ = sample_rates_.is_sampling();
+
+  // Set the throttling thresholds.
+  throttle_calls_ = 0;
+  char const *env_throttle_calls = std::getenv("VERNIER_THROTTLE_CALLS");
+  if (env_throttle_calls) {
+    char *end = nullptr;
+    throttle_calls_ = std::strtoull(env_throttle_calls, &end, 10);
+    if (end == env_throttle_calls || *end != '\0' || throttle_calls_ == 0 ||
+        env_throttle_calls[0] == '-') {
+      error_handler("Invalid VERNIER_THROTTLE_CALLS. Expected a positive "
+                    "integer, but it is set to '" +
+                        std::string(env_throttle_calls) + "'.",
+                    EXIT_FAILURE);
+    }
+  }
+  throttle_usec_ = PROF_THROTTLE_USEC;
+  char const *env_throttle_usec = std::getenv("VERNIER_THROTTLE_USEC");
+  if (env_throttle_usec) {
+    char *end = nullptr;
+    throttle_usec_ = std::strtod(env_throttle_usec, &end);
+    if (end == env_throttle_usec || *end != '\0' || !(throttle_usec_ > 0.0)) {
+      error_handler("Invalid VERNIER_THROTTLE_USEC. Expected a positive "
+                    "number, but it is set to '" +
+                        std::string(env_throttle_usec) + "'.",
+                    EXIT_FAILURE);
+    }
+  }
+  selective_timing_ = sampling_ || throttle_calls_ > 0;
+
+  // Set the region filter.
+  region_filter_.clear();
+  char const *env_include = std::getenv("VERNIER_INCLUDE");
+  if (env_include) {
+    region_filter_.add_include_patterns(env_include);
+  }
+  char const *env_exclude = std::getenv("VERNIER_EXCLUDE");
+  if (env_exclude) {
+    region_filter_.add_exclude_patterns(env_exclude);
+  }
+  char const *env_filter_file = std::getenv("VERNIER_FILTER_FILE");
+  if (env_filter_file) {
+    region_filter_.read_file(env_filter_file);
+  }
+  filtering_ = region_filter_.is_active();
+  deferred_clock_ = selective_timing_ || filtering_;
+  table_capacity_ = PROF_HASHVEC_RESERVE_SIZE;
+  if (region_filter_.get_expected_regions() > 0) {
+    table_capacity_ = region_filter_.get_expected_regions();
+  }
+
+  // Set the maximum number of regions. Space is reserved for no more than
+  // that, plus the profiler and overflow records.
+  max_regions_ = 0;
+  char const *env_max_regions = std::getenv("VERNIER_MAX_REGIONS");
+  if (env_max_regions) {
+    char *end = nullptr;
+    auto const max_regions = std::strtoull(env_max_regions, &end, 10);
+    if (end == env_max_regions || *end != '\0' || max_regions == 0 ||
+        env_max_regions[0] == '-') {
+      error_handler("Invalid VERNIER_MAX_REGIONS. Expected a positive "
+                    "integer, but it is set to '" +
+                        std::string(env_max_regions) + "'.",
+                    EXIT_FAILURE);
+    }
+    max_regions_ = static_cast<std::size_t>(max_regions);
+    table_capacity_ = std::min(table_capacity_, max_regions_ + 3);
+  }
+
+  // Set the number of warm-up calls of each region.
+  warmup_calls_ = 0;
+  steady_state_epoch_ = 0;
+  char const *env_warmup_calls = std::getenv("VERNIER_WARMUP_CALLS");
+  if (env_warmup_calls) {
+    char *end = nullptr;
+    warmup_calls_ = std::strtoull(env_warmup_calls, &end, 10);
+    if (end == env_warmup_calls || *end != '\0' || warmup_calls_ == 0 ||
+        env_warmup_calls[0] == '-') {
+      error_handler("Invalid VERNIER_WARMUP_CALLS. Expected a positive "
+                    "integer, but it is set to '" +
+                        std::string(env_warmup_calls) + "'.",
+                    EXIT_FAILURE);
+    }
+  }
+
+  // Set whether regions are profiled by call path, and to what depth.
+  call_tree_ = false;
+  char const *env_call_tree = std::getenv("VERNIER_CALL_TREE");
+  if (env_call_tree) {
+    std::string const call_tree = env_call_tree;
+    if (call_tree == "1") {
+      call_tree_ = true;
+    } else if (call_tree != "0") {
+      error_handler("Invalid VERNIER_CALL_TREE. Expected '0' or '1'. "
+                    "Currently set to '" +
+                        call_tree + "'.",
+                    EXIT_FAILURE);
+    }
+  }
+  call_tree_depth_ = max_depth_;
+  char const *env_call_tree_depth = std::getenv("VERNIER_CALL_TREE_DEPTH");
+  if (env_call_tree_depth) {
+    char *end = nullptr;
+    long const call_tree_depth = std::strtol(env_call_tree_depth, &end, 10);
+    if (end == env_call_tree_depth || *end != '\0' || call_tree_depth < 1 ||
+        call_tree_depth > std::numeric_limits<int>::max()) {
+      error_handler("Invalid VERNIER_CALL_TREE_DEPTH. Expected a positive "
+                    "integer, but it is set to '" +
+                        std::string(env_call_tree_depth) + "'.",
+                    EXIT_FAILURE);
+    }
+    call_tree_depth_ = std::min(max_depth_, static_cast<int>(call_tree_depth));
   }
 
   // Initialise MPI context
   mpi_context_.init(client_comm_handle, tag);
 
-  // Set Vernier initialised.
+  // Set Vernier initialised. Thread state pointers left over from a previous
+  // profile are now stale.
+  ++epoch_;
   initialized_ = true;
 
+  // Lean callipers do not time themselves, and compensated output needs the
+  // cost of a calliper pair. The costs are calibrated here, once, so that no
+  // thread's regions are charged for it. Lean callipers charge everything
+  // outside the region as overhead, so none of the pair cost is left in the
+  // parent's self time.
+  calliper_costs_ = CalliperCosts{};
+  lean_calliper_cost_ = 0;
+  if (calliper_mode_ == CalliperMode::lean || compensate_) {
+    calliper_costs_ = calibrate_callipers();
+  }
+  if (calliper_mode_ == CalliperMode::lean) {
+    lean_calliper_cost_ = std::max(
+        time_duration_t{0},
+        static_cast<time_duration_t>(std::llround(
+            calliper_costs_.pair_cost_ - calliper_costs_.region_cost_)));
+    calliper_costs_.gap_cost_ = 0.0;
+  }
+
+  // Register the calling thread, so that its state is always present.
+  register_thread();
+
   // Assertions
-  assert(static_cast<int>(thread_hashtables_.size()) == max_threads_);
-  assert(static_cast<int>(thread_traceback_.size()) == max_threads_);
   assert(mpi_context_.is_initialized());
   assert(initialized_);
 #ifndef NDEBUG
@@ -95,16 +345,17 @@ void meto::Vernier::finalize() {
     mpi_context_.finalize();
   }
 
-  // Empty the traceback and hashtable
-  thread_hashtables_.clear();
-  thread_traceback_.clear();
+  // Free the per-thread state. Threads still pointing at their old state
+  // will see the epoch change and re-register.
+  thread_states_.clear();
+  ++epoch_;
 
-  // Set Vernier not initialised.
+  // Set Vernier not initialised. VERNIER_ENABLE is read again on next use.
   initialized_ = false;
+  enable_state_.store(EnableState::unread, std::memory_order_relaxed);
 
   // Assertions
-  assert(static_cast<int>(thread_hashtables_.size()) == 0);
-  assert(static_cast<int>(thread_traceback_.size()) == 0);
+  assert(thread_states_.empty());
   assert(!mpi_context_.is_initialized());
   assert(!initialized_);
 }
@@ -113,30 +364,48 @@ void meto::Vernier::finalize() {
  * @brief   Start timing a profiled code region.
  * @details Calls both part1 and part2 start routines in succession.
  * @param [in]  region_name   The code region name.
- * @returns     Unique hash for the code region being started.
+ * @returns     Unique hash for the code region being started, or 0 if
+ *              profiling is disabled.
  */
 
 size_t meto::Vernier::start(std::string_view const region_name) {
+  if (disabled()) {
+    return 0;
+  }
+
   start_part1();
   auto hash = start_part2(region_name);
   return hash;
 }
 
 /**
- * @brief  Start timing a profiled code region, part 1 of 2: make a
- *         threadprivate note of the time.
+ * @brief   Start timing an indexed code region.
+ * @details Each pair of region name and key is profiled as a separate region,
+ *          named name[key] in the output. The key is mixed into the hash of
+ *          the name, so no string is formatted once the region has been met.
+ * @param [in]  region_name   The code region name.
+ * @param [in]  key           The key, such as a level or iteration number.
+ * @returns     Unique hash for the indexed region being started, or 0 if
+ *              profiling is disabled.
  */
 
-void meto::Vernier::start_part1() {
-
-  // Check that Vernier has been initialised
-  if (!initialized_) {
-    meto::error_handler("Vernier::start_part1. Vernier not initialised.",
-                        EXIT_FAILURE);
+size_t meto::Vernier::start_indexed(std::string_view const region_name,
+                                    int const key) {
+  if (disabled()) {
+    return 0;
   }
 
-  // Store the calliper start time, which is used in part2.
-  logged_calliper_start_time_ = vernier_gettime();
+  start_part1();
+
+  // The calling thread was registered, if need be, by start_part1.
+  auto &state = *thread_state_;
+
+  size_t hash;
+  record_index_t record_index;
+  state.table_.query_insert_indexed(region_name, key, state.tid_, hash,
+                                    record_index);
+  start_record(state, hash, record_index);
+  return hash;
 }
 
 /**
@@ -146,126 +415,288 @@ void meto::Vernier::start_part1() {
  */
 
 size_t meto::Vernier::start_part2(std::string_view const region_name) {
-  // Determine the thread number
-  auto tid = static_cast<hashtable_iterator_t_>(0);
-#ifdef _OPENMP
-  tid = static_cast<hashtable_iterator_t_>(omp_get_thread_num());
-#endif
-  auto tid_int = static_cast<int>(tid);
 
-  assert(tid <= thread_hashtables_.size());
-  assert(tid <= thread_traceback_.size());
+  // The calling thread was registered, if need be, by start_part1.
+  auto &state = *thread_state_;
 
   size_t hash;
   record_index_t record_index;
-  thread_hashtables_[tid].query_insert(region_name, tid_int, hash,
-                                       record_index);
-  thread_hashtables_[tid].increment_recursion_level(record_index);
-
-  // Store the calliper and region start times.
-  ++call_depth_;
-  if (call_depth_ < PROF_MAX_TRACEBACK_SIZE) {
-    auto call_depth_index = static_cast<traceback_index_t>(call_depth_);
-    auto region_start_time = vernier_gettime();
-    thread_traceback_[tid].at(call_depth_index) = TracebackEntry(
-        hash, record_index, region_start_time, logged_calliper_start_time_);
-  } else {
-    error_handler("EMERGENCY STOP: Traceback array exhausted.", EXIT_FAILURE);
-  }
+  state.table_.query_insert(region_name, state.tid_, hash, record_index);
+  start_record(state, hash, record_index);
   return hash;
 }
 
 /**
- * @brief  Stop timing a profiled code region.
- * @param [in] hash   Hash of the profiled code region being stopped.
- * @note  The calliper time (spent in the profiler) is measured by
- *        differencing the beginning of the start calliper from the end of the
- * stop calliper, and subtracting the measured region time. Hence larger
- *        absolute times are being measured, which are less likely to suffer
- *        fractional error from precision limitations of the clock.
+ * @brief   Count events against a named region, without timing.
+ * @details The events are reported in the region's calls column. No clock is
+ *          read and the traceback is not touched.
+ * @param [in]  region_name   The region name.
+ * @param [in]  count         The number of events.
  */
 
-void meto::Vernier::stop(size_t const hash) {
+void meto::Vernier::count(std::string_view const region_name,
+                          unsigned long long int const count) {
+  if (disabled()) {
+    return;
+  }
 
-  // Log the region stop time.
-  auto region_stop_time = vernier_gettime();
+  if (!initialized_) {
+    meto::error_handler("Vernier::count. Vernier not initialised.",
+                        EXIT_FAILURE);
+  }
+
+  auto &state = this_thread_state();
 
-  // Determine the thread number
-  auto tid = static_cast<hashtable_iterator_t_>(0);
+  size_t hash;
+  record_index_t record_index;
+  state.table_.query_insert(region_name, state.tid_, hash, record_index);
+  state.table_.add_events(record_index, count);
+}
+
+/**
+ * @brief  Register the calling thread, creating its state block.
+ * @returns  Reference to the new state block.
+ * @details The thread takes the slot matching its OpenMP thread number, if that
+ *          slot is free. Otherwise, for example for threads not created by
+ *          OpenMP, it takes the first free slot after those reserved for the
+ *          OpenMP team. The slot is the thread ID reported in the output.
+ * @note  Called on a thread's first calliper after each init().
+ */
+
+meto::Vernier::ThreadState &meto::Vernier::register_thread() {
+
+  if (!initialized_) {
+    meto::error_handler("Vernier::register_thread. Vernier not initialised.",
+                        EXIT_FAILURE);
+  }
+
+  std::lock_guard<std::mutex> lock(thread_states_mutex_);
+
+  auto slot = static_cast<thread_index_t>(0);
 #ifdef _OPENMP
-  tid = static_cast<hashtable_iterator_t_>(omp_get_thread_num());
+  slot = static_cast<thread_index_t>(omp_get_thread_num());
 #endif
 
-  // Check that we have called a start calliper before the stop calliper.
-  // If not, then the call depth would be -1.
-  if (call_depth_ < 0) {
-    error_handler("EMERGENCY STOP: stop called before start calliper.",
+  if (slot < thread_states_.size() && thread_states_[slot]) {
+    slot = std::max(static_cast<thread_index_t>(max_threads_), slot);
+    while (slot < thread_states_.size() && thread_states_[slot]) {
+      ++slot;
+    }
+  }
+
+  if (slot >= thread_states_.size()) {
+    thread_states_.resize(slot + 1);
+  }
+
+  // Start with a small traceback, which grows as needed.
+  auto const traceback_size =
+      std::min(static_cast<traceback_index_t>(PROF_TRACEBACK_CHUNK_SIZE),
+               static_cast<traceback_index_t>(max_depth_));
+  thread_states_[slot] = std::make_unique<ThreadState>(
+      static_cast<int>(slot), traceback_size, table_capacity_);
+
+  auto &state = *thread_states_[slot];
+  state.lean_calliper_cost_ = lean_calliper_cost_;
+  state.calliper_costs_ = calliper_costs_;
+  if (sampling_) {
+    state.table_.set_sample_rates(sample_rates_);
+  }
+  if (filtering_) {
+    state.table_.set_region_filter(region_filter_);
+  }
+  if (max_regions_ > 0) {
+    state.table_.set_max_regions(max_regions_);
+  }
+  if (call_tree_) {
+    state.table_.set_call_tree();
+  }
+  if (steady_state_epoch_ > 0) {
+    apply_steady_state(state);
+  } else if (warmup_calls_ > 0) {
+    state.table_.set_warmup_calls(warmup_calls_);
+  }
+  if (throttle_calls_ > 0) {
+    state.table_.set_throttle(throttle_calls_,
+                              throttle_usec_ * 1.0e-6 /
+                                  clock_settings.seconds_per_tick_);
+  }
+
+  thread_state_ = &state;
+  thread_state_epoch_ = epoch_;
+  return *thread_state_;
+}
+
+/**
+ * @brief  Measure the cost of a calliper pair.
+ * @details Times batches of empty regions on a scratch thread state, in the
+ *          current calliper mode. The batch time per pair is the cost that a
+ *          region adds to its parent; the measured region time per pair is
+ *          the part of that seen by the region itself. The cheapest batch is
+ *          used, to discount interruptions.
+ * @returns  The calibrated costs, in clock ticks.
+ * @note  Called by init(), before the calling thread's state exists.
+ */
+
+meto::CalliperCosts meto::Vernier::calibrate_callipers() {
+
+  ThreadState scratch(0, PROF_TRACEBACK_CHUNK_SIZE, PROF_HASHVEC_RESERVE_SIZE);
+  thread_state_ = &scratch;
+  thread_state_epoch_ = epoch_;
+
+  // Time the pairs inside a parent region, as they would be when profiling.
+  auto const parent_hash = start("__vernier_calibration_parent__");
+
+  CalliperCosts costs;
+  costs.pair_cost_ = std::numeric_limits<double>::max();
+  double region_time = 0.0;
+  double overhead_time = 0.0;
+  for (int batch = 0; batch < PROF_CALIBRATION_BATCHES; ++batch) {
+    size_t hash = 0;
+    auto const batch_start_time = vernier_gettime();
+    for (int pair = 0; pair < PROF_CALIBRATION_BATCH_SIZE; ++pair) {
+      hash = start("__vernier_calibration__");
+      stop(hash);
+    }
+    auto const batch_time = vernier_gettime() - batch_start_time;
+
+    // Region and overhead times are only available in seconds.
+    double const new_region_time = scratch.table_.get_total_walltime(hash);
+    double const new_overhead_time =
+        scratch.table_.get_overhead_walltime(parent_hash);
+    double const batch_region_time = new_region_time - region_time;
+    double const batch_overhead_time = new_overhead_time - overhead_time;
+    region_time = new_region_time;
+    overhead_time = new_overhead_time;
+
+    double const per_pair =
+        clock_settings.seconds_per_tick_ * PROF_CALIBRATION_BATCH_SIZE;
+    double const pair_cost = static_cast<double>(batch_time) /
+                             PROF_CALIBRATION_BATCH_SIZE;
+    if (pair_cost < costs.pair_cost_) {
+      costs.pair_cost_ = pair_cost;
+      costs.region_cost_ = batch_region_time / per_pair;
+      costs.gap_cost_ =
+          pair_cost - costs.region_cost_ - batch_overhead_time / per_pair;
+    }
+  }
+  stop(parent_hash);
+
+  // Leave the scratch state unreachable.
+  thread_state_ = nullptr;
+  thread_state_epoch_ = 0;
+
+  return costs;
+}
+
+/**
+ * @brief  Extend the calling thread's traceback by one chunk, up to the
+ *         maximum depth.
+ * @param [inout] state  The calling thread's state.
+ */
+
+void meto::Vernier::grow_traceback(ThreadState &state) const {
+  auto const max_depth = static_cast<traceback_index_t>(max_depth_);
+  auto const current_size = state.traceback_.size();
+
+  if (current_size >= max_depth) {
+    error_handler("EMERGENCY STOP: Traceback array exhausted. The maximum "
+                  "depth is " +
+                      std::to_string(max_depth_) +
+                      ", which can be raised with VERNIER_MAX_DEPTH.",
                   EXIT_FAILURE);
   }
 
-  // Get reference to the traceback entry.
-  auto call_depth_index = static_cast<traceback_index_t>(call_depth_);
-  auto &traceback_entry = thread_traceback_[tid].at(call_depth_index);
-
-  // Check: which hash is last on the traceback list?
-  size_t last_hash_on_list = traceback_entry.record_hash_;
-  if (hash != last_hash_on_list) {
-    std::string error_msg =
-        "EMERGENCY STOP: hashes don't match. Expected calliper: " +
-        thread_hashtables_[tid].get_decorated_region_name(last_hash_on_list) +
-        " Received calliper: " +
-        thread_hashtables_[tid].get_decorated_region_name(hash) + "\n";
-    error_handler(error_msg, EXIT_FAILURE);
-  }
-
-  // Compute the region time
-  auto region_duration = region_stop_time - traceback_entry.region_start_time_;
-
-  // Do the hashtable update for the child region.
-  thread_hashtables_[tid].decrement_recursion_level(
-      traceback_entry.record_index_);
-  thread_hashtables_[tid].update(traceback_entry.record_index_,
-                                 region_duration);
-
-  // Precompute times as far as possible. We just need the calliper stop time
-  // later.
-  //   (t4-t1) = calliper time + region duration
-  //   (t3-t2) = region_duration
-  //   calliper_time = (t4-t1) - (t3-t2)  = t4 - ( t3-t2 + t1)
-  auto temp_sum = traceback_entry.calliper_start_time_ + region_duration;
-
-  // The sequence of code that follows is aimed at leaving only minimal and
-  // simple operations after the call to vernier_gettime().
-  time_duration_t *parent_overhead_time_ptr = nullptr;
-  time_duration_t *profiler_overhead_time_ptr = nullptr;
-
-  // Acquire parent pointers
-  if (call_depth_ > 0) {
-    auto parent_depth = static_cast<traceback_index_t>(call_depth_ - 1);
-    record_index_t parent_index =
-        thread_traceback_[tid].at(parent_depth).record_index_;
-    thread_hashtables_[tid].add_child_time_to_parent(
-        parent_index, region_duration, parent_overhead_time_ptr);
-  }
-
-  // Increment profiler calls, and get a pointer to the total overhead time.
-  thread_hashtables_[tid].add_profiler_call(profiler_overhead_time_ptr);
-
-  // Decrement index to last entry in the traceback.
-  --call_depth_;
-
-  // Account for time spent in the profiler itself.
-  auto calliper_stop_time = vernier_gettime();
-  auto calliper_time = calliper_stop_time - temp_sum;
-
-  // Increment the overhead time specific to this region, incurred when calling
-  // direct children, and also the overall profiling overhead time.
-  // Being outside the stop calliper, these operations need to be as cheap
-  // as possible.
-  if (parent_overhead_time_ptr) {
-    *parent_overhead_time_ptr += calliper_time;
-  }
-  *profiler_overhead_time_ptr += calliper_time;
+  state.traceback_.resize(
+      std::min(current_size + PROF_TRACEBACK_CHUNK_SIZE, max_depth));
+}
+
+/**
+ * @brief  Get the state of a specified thread, for the getters.
+ * @param [in] input_tid  The thread ID.
+ * @returns  Reference to the thread's state block.
+ */
+
+meto::Vernier::ThreadState &
+meto::Vernier::get_thread_state(int const input_tid) const {
+  auto tid = static_cast<thread_index_t>(input_tid);
+  if (input_tid < 0 || tid >= thread_states_.size() || !thread_states_[tid]) {
+    meto::error_handler("Vernier: no profiling data for thread " +
+                            std::to_string(input_tid) + ".",
+                        EXIT_FAILURE);
+  }
+  return *thread_states_[tid];
+}
+
+/**
+ * @brief  Resolve a region handle into a region record on the calling thread,
+ *         inserting the record if necessary.
+ * @param [in]  state         The calling thread's state.
+ * @param [in]  handle        The region handle.
+ * @param [out] hash          Hash of the region name.
+ * @param [out] record_index  Array index of the region record.
+ * @note  Called only the first time a handle is started on each thread.
+ */
+
+void meto::Vernier::resolve_handle(ThreadState &state,
+                                   RegionHandle const handle, size_t &hash,
+                                   record_index_t &record_index) {
+  state.table_.query_insert(region_registry_.get_name(handle), state.tid_,
+                            hash, record_index);
+  state.table_.insert_handle(handle, record_index);
+}
+
+/**
+ * @brief  Abort on a stop calliper that does not match the innermost region.
+ * @param [in] state          The calling thread's state.
+ * @param [in] expected_hash  Hash of the innermost region on the traceback.
+ * @param [in] received_hash  Hash passed to the stop calliper.
+ */
+
+void meto::Vernier::report_mismatch(ThreadState const &state,
+                                    size_t const expected_hash,
+                                    size_t const received_hash) const {
+  std::string error_msg =
+      "EMERGENCY STOP: hashes don't match. Expected calliper: " +
+      state.table_.get_decorated_region_name(expected_hash) +
+      " Received calliper: " +
+      state.table_.get_decorated_region_name(received_hash) + "\n";
+  error_handler(error_msg, EXIT_FAILURE);
+}
+
+/**
+ * @brief  Registers a region name, so that it can be started and stopped
+ *         without hashing the name on each call.
+ * @param [in]  region_name   The code region name.
+ * @returns     Handle for the region, valid on all threads and across
+ *              init/finalize cycles.
+ * @note  May be called before init(). While profiling is disabled, nothing is
+ *        registered and the handle returned is not valid once it is enabled.
+ */
+
+meto::RegionHandle
+meto::Vernier::register_region(std::string_view const region_name) {
+  if (disabled()) {
+    return unregistered_region_handle;
+  }
+  return region_registry_.insert(region_name, hash_region_name(region_name));
+}
+
+/**
+ * @brief  Registers a region name whose hash has already been computed.
+ * @param [in]  region_name   The code region name.
+ * @param [in]  hash          Hash of the region name, from hash_region_name.
+ * @returns     Handle for the region.
+ * @note  Used by the VERNIER_REGION macro, which hashes string literals at
+ *        compile time.
+ */
+
+meto::RegionHandle
+meto::Vernier::register_region(std::string_view const region_name,
+                               size_t const hash) {
+  if (disabled()) {
+    return unregistered_region_handle;
+  }
+  return region_registry_.insert(region_name, hash);
 }
 
 /**
@@ -278,20 +709,134 @@ void meto::Vernier::stop(size_t const hash) {
 
 void meto::Vernier::write() {
 
+  // No profile is written when profiling is disabled.
+  if (disabled()) {
+    return;
+  }
+
   if (!initialized_) {
     meto::error_handler("Vernier::write. Vernier not initialised.",
                         EXIT_FAILURE);
   }
 
-  // Create hashvec handler object and feed in data from thread_hashtables_
+  // Create hashvec handler object and feed in data from each thread
   HashVecHandler output_data(mpi_context_);
-  for (auto &table : thread_hashtables_) {
-    table.append_to(output_data);
+
+  for (auto &state : thread_states_) {
+    if (state) {
+      // Threads that have not stopped a region since the steady state was
+      // marked have not applied the mark yet.
+      apply_steady_state(*state);
+      if (compensate_) {
+        state->table_.append_to(output_data, state->calliper_costs_);
+      } else {
+        state->table_.append_to(output_data);
+      }
+    }
+  }
+
+  // Describe non-default calliper modes in the output.
+  profile_notes_t notes;
+  if (calliper_mode_ == CalliperMode::lean) {
+    notes.push_back("Calliper mode: lean. Overheads are estimated at " +
+                    describe_cost(static_cast<double>(lean_calliper_cost_)) +
+                    " per calliper pair.");
+  }
+  if (compensate_) {
+    notes.push_back("Overhead compensation: on. Times exclude an estimated " +
+                    describe_cost(calliper_costs_.pair_cost_) +
+                    " per nested calliper pair.");
+  }
+
+  if (sampling_) {
+    notes.push_back("Sampling: on. Regions marked * were timed on a sample of "
+                    "their calls, or had children that were, so their times "
+                    "are estimates.");
+  }
+  if (filtering_) {
+    notes.push_back("Filtering: on. Regions filtered out are not shown, and "
+                    "their time is in their parents' self times.");
+  }
+  if (throttle_calls_ > 0) {
+    std::ostringstream throttle_usec;
+    throttle_usec << throttle_usec_;
+    notes.push_back("Throttling: on. Regions marked # averaged under " +
+                    throttle_usec.str() + " us per call over at least " +
+                    std::to_string(throttle_calls_) +
+                    " calls, and were then only counted. Their times cover "
+                    "the calls before that.");
+  }
+
+  if (max_regions_ > 0) {
+    std::vector<std::uint64_t> overflow_names(PROF_OVERFLOW_BITMAP_WORDS, 0);
+    for (auto &state : thread_states_) {
+      if (state) {
+        state->table_.merge_overflow_names(overflow_names);
+      }
+    }
+    notes.push_back("Region limit: " + std::to_string(max_regions_) +
+                    " regions per thread. " +
+                    describe_overflow(overflow_names) + " folded into " +
+                    PROF_OVERFLOW_REGION + ".");
+  }
+
+  if (call_tree_) {
+    std::string const depth =
+        call_tree_depth_ < max_depth_
+            ? ", to a depth of " + std::to_string(call_tree_depth_) +
+                  " regions. Deeper regions are named by their own name"
+            : "";
+    notes.push_back(std::string("Call tree: on. Regions are named by their "
+                                "call path, separated by '") +
+                    PROF_CALL_PATH_SEPARATOR + "'" + depth + ".");
+  }
+  if (steady_state_epoch_ > 0) {
+    std::string const warmup_calls =
+        warmup_calls_ > 0 ? ", or the first " + std::to_string(warmup_calls_) +
+                                " calls of a region if they ended sooner,"
+                          : "";
+    notes.push_back("Warm-up: on. Calls that ended before the steady state "
+                    "was marked" +
+                    warmup_calls +
+                    " are left out of the other columns, and shown in the "
+                    "warm-up columns.");
+  } else if (warmup_calls_ > 0) {
+    notes.push_back("Warm-up: on. The first " + std::to_string(warmup_calls_) +
+                    " calls of each region are left out of the other "
+                    "columns, and shown in the warm-up columns.");
   }
 
   // Sort hashvec from high to low self walltimes then write
   output_data.sort();
-  output_data.write();
+  output_data.write(notes);
+}
+
+/**
+ * @brief   Mark the end of the warm-up, on every thread.
+ * @details Calls of each region that ended before now are warm-up calls,
+ *          which are left out of the times written and reported separately.
+ *          Regions that are open now are in the steady state.
+ *          The mark is applied to the calling thread's records now, and to
+ *          each other thread's records by that thread, at its next stop
+ *          calliper, or else when the profile is written. Callipers running
+ *          on other threads are therefore not disturbed.
+ */
+
+void meto::Vernier::mark_steady_state() {
+
+  if (disabled()) {
+    return;
+  }
+
+  if (!initialized_) {
+    meto::error_handler("Vernier::mark_steady_state. Vernier not initialised.",
+                        EXIT_FAILURE);
+  }
+
+  ++steady_state_epoch_;
+  if (thread_state_epoch_ == epoch_) {
+    apply_steady_state(*thread_state_);
+  }
 }
 
 /**
@@ -305,8 +850,10 @@ void meto::Vernier::write() {
 
 double meto::Vernier::get_total_walltime(size_t const hash,
                                          int const thread_id) {
-  auto tid = static_cast<hashtable_iterator_t_>(thread_id);
-  return thread_hashtables_[tid].get_total_walltime(hash);
+  if (disabled()) {
+    return 0.0;
+  }
+  return get_thread_state(thread_id).table_.get_total_walltime(hash);
 }
 
 /**
@@ -320,8 +867,10 @@ double meto::Vernier::get_total_walltime(size_t const hash,
 
 double meto::Vernier::get_overhead_walltime(size_t const hash,
                                             int const thread_id) {
-  auto tid = static_cast<hashtable_iterator_t_>(thread_id);
-  return thread_hashtables_[tid].get_overhead_walltime(hash);
+  if (disabled()) {
+    return 0.0;
+  }
+  return get_thread_state(thread_id).table_.get_overhead_walltime(hash);
 }
 
 /**
@@ -335,8 +884,10 @@ double meto::Vernier::get_overhead_walltime(size_t const hash,
 
 double meto::Vernier::get_self_walltime(size_t const hash,
                                         int const input_tid) {
-  auto tid = static_cast<hashtable_iterator_t_>(input_tid);
-  return thread_hashtables_[tid].get_self_walltime(hash);
+  if (disabled()) {
+    return 0.0;
+  }
+  return get_thread_state(input_tid).table_.get_self_walltime(hash);
 }
 
 /**
@@ -353,8 +904,10 @@ double meto::Vernier::get_self_walltime(size_t const hash,
 
 double meto::Vernier::get_child_walltime(size_t const hash,
                                          int const input_tid) const {
-  auto tid = static_cast<hashtable_iterator_t_>(input_tid);
-  return thread_hashtables_[tid].get_child_walltime(hash);
+  if (disabled()) {
+    return 0.0;
+  }
+  return get_thread_state(input_tid).table_.get_child_walltime(hash);
 }
 
 /**
@@ -372,8 +925,10 @@ double meto::Vernier::get_child_walltime(size_t const hash,
 std::string
 meto::Vernier::get_decorated_region_name(size_t const hash,
                                          int const input_tid) const {
-  auto tid = static_cast<hashtable_iterator_t_>(input_tid);
-  return thread_hashtables_[tid].get_decorated_region_name(hash);
+  if (disabled()) {
+    return "";
+  }
+  return get_thread_state(input_tid).table_.get_decorated_region_name(hash);
 }
 
 /**
@@ -390,8 +945,27 @@ meto::Vernier::get_decorated_region_name(size_t const hash,
 
 unsigned long long int
 meto::Vernier::get_call_count(size_t const hash, int const input_tid) const {
-  auto tid = static_cast<hashtable_iterator_t_>(input_tid);
-  return thread_hashtables_[tid].get_call_count(hash);
+  if (disabled()) {
+    return 0;
+  }
+  return get_thread_state(input_tid).table_.get_call_count(hash);
+}
+
+/**
+ * @brief  Get the number of events counted against the input hash region on
+ *         the input thread ID.
+ *
+ * @param[in] hash       The hash corresponding to the region of interest.
+ * @param[in] input_tid  The ID corresponding to the thread of interest.
+ *
+ */
+
+unsigned long long int
+meto::Vernier::get_event_count(size_t const hash, int const input_tid) const {
+  if (disabled()) {
+    return 0;
+  }
+  return get_thread_state(input_tid).table_.get_event_count(hash);
 }
 
 /**
@@ -406,6 +980,8 @@ meto::Vernier::get_call_count(size_t const hash, int const input_tid) const {
 
 unsigned long long int
 meto::Vernier::get_prof_call_count(int const input_tid) const {
-  auto tid = static_cast<hashtable_iterator_t_>(input_tid);
-  return thread_hashtables_[tid].get_prof_call_count();
+  if (disabled()) {
+    return 0;
+  }
+  return get_thread_state(input_tid).table_.get_prof_call_count();
 }
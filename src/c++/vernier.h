@@ -17,7 +17,11 @@
 #define VERNIER_H
 
 #include <array>
+#include <atomic>
+#include <climits>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <string_view>
 #include <vector>
 
@@ -27,9 +31,24 @@
 
 #include "hashtable.h"
 #include "mpi_context.h"
+#include "region_filter.h"
+#include "region_registry.h"
+#include "sample_rates.h"
+#include "vernier_hash.h"
 #include "vernier_mpi.h"
 
 #define PROF_MAX_TRACEBACK_SIZE 1000
+#define PROF_TRACEBACK_CHUNK_SIZE 32
+#define PROF_CALIBRATION_BATCHES 5
+#define PROF_CALIBRATION_BATCH_SIZE 1000
+#define PROF_THROTTLE_USEC 10.0
+#define PROF_CACHE_LINE_SIZE 64
+
+// Highest instrumentation level compiled into client code. Callipers tagged
+// with a higher level compile to nothing. By default, every level is kept.
+#ifndef VERNIER_MAX_LEVEL
+#define VERNIER_MAX_LEVEL INT_MAX
+#endif
 
 namespace meto {
 
@@ -37,14 +56,35 @@ namespace meto {
 // to private methods.
 extern "C" {
 void c_vernier_start_part1();
-void c_vernier_start_part2(long int &hash_out, char const *name);
+void c_vernier_start_part2(long int *hash_out, char const *name);
 }
 
+/**
+ * @brief  Whether callipers tagged with an instrumentation level are compiled
+ *         in. Lower levels are coarser.
+ * @details The maximum level is a template parameter, rather than read from
+ *          the macro directly, so that translation units built with different
+ *          maximum levels instantiate distinct templates.
+ */
+
+template <int Level, int MaxLevel = VERNIER_MAX_LEVEL>
+inline constexpr bool level_enabled = (Level <= MaxLevel);
+
+/**
+ * @brief  How the callipers account for their own overhead.
+ */
+
+enum class CalliperMode {
+  full, // Measure the overhead of every calliper pair: four clock reads.
+  lean  // Estimate the overhead from a calibration run: two clock reads.
+};
+
 /**
  * @brief  Top-level Vernier class.
  *
  * Maintains separate hashtables for each thread, and keeps a breadcrumb trail
- * of profiled regions.
+ * of profiled regions. Any thread may enter a calliper, whether or not it
+ * belongs to an OpenMP team.
  */
 
 class Vernier {
@@ -58,43 +98,170 @@ class Vernier {
   public:
     // Constructors
     TracebackEntry() = default;
-    TracebackEntry(size_t, record_index_t, time_point_t, time_point_t);
+    TracebackEntry(size_t, record_index_t, time_point_t, time_point_t,
+                   unsigned long long int, bool);
 
     // Data members
     size_t record_hash_;
     record_index_t record_index_;
     time_point_t region_start_time_;
     time_point_t calliper_start_time_;
+    unsigned long long int calliper_pairs_start_;
+    bool timed_;
+  };
+
+  /**
+   * @brief  Profiler state belonging to a single thread.
+   *
+   * Each thread registers its own block the first time it enters a calliper,
+   * and thereafter reaches it through a thread_local pointer. Blocks are
+   * allocated separately and aligned to cache lines, so that no two threads
+   * write to the same cache line.
+   */
+
+  struct alignas(PROF_CACHE_LINE_SIZE) ThreadState {
+  public:
+    // Constructors
+    ThreadState() = delete;
+    ThreadState(int const tid, std::size_t const traceback_size,
+                std::size_t const table_capacity)
+        : tid_(tid), table_(tid, table_capacity), traceback_(traceback_size) {}
+
+    // Data members
+    int tid_;
+    HashTable table_;
+    std::vector<TracebackEntry> traceback_;
+    int call_depth_ = -1;
+    time_point_t logged_calliper_start_time_{};
+
+    // Number of calliper pairs completed, for counting nested pairs.
+    unsigned long long int calliper_pairs_ = 0;
+
+    // Copies of the calibrated calliper costs, and in lean mode the overhead
+    // charged for each calliper pair.
+    CalliperCosts calliper_costs_{};
+    time_duration_t lean_calliper_cost_ = 0;
+
+    // The steady-state mark last applied to this thread's records.
+    unsigned long steady_state_epoch_ = 0;
   };
 
   // Default initialisation flag.  No explicit constructor, and pointless
   // to set this in the init() method.
   bool initialized_ = false;
 
+  // Whether profiling is enabled, from VERNIER_ENABLE. When it is not, every
+  // calliper returns at once, without reading the clock, hashing or
+  // allocating. The variable is read by init(), or else by the first entry
+  // point called, so that callipers reached before init() are also disabled.
+  enum class EnableState : unsigned char { unread, enabled, disabled };
+  mutable std::atomic<EnableState> enable_state_ = EnableState::unread;
+
   // Data members
   int max_threads_;
 
+  // Maximum traceback depth, from VERNIER_MAX_DEPTH.
+  int max_depth_ = PROF_MAX_TRACEBACK_SIZE;
+
+  // Calliper mode, from VERNIER_CALLIPER_MODE.
+  CalliperMode calliper_mode_ = CalliperMode::full;
+
+  // Whether output times are compensated for calliper overheads, from
+  // VERNIER_COMPENSATE.
+  bool compensate_ = false;
+
+  // Calliper costs, calibrated once by init() when needed, and in lean mode
+  // the overhead charged for each calliper pair. Copied to each thread.
+  CalliperCosts calliper_costs_{};
+  time_duration_t lean_calliper_cost_ = 0;
+
+  // Sample rates, from VERNIER_SAMPLE_RATE and VERNIER_SAMPLE_REGIONS, and
+  // whether any region is sampled.
+  SampleRates sample_rates_;
+  bool sampling_ = false;
+
+  // Throttling thresholds, from VERNIER_THROTTLE_CALLS and
+  // VERNIER_THROTTLE_USEC. Zero calls disables throttling.
+  unsigned long long int throttle_calls_ = 0;
+  double throttle_usec_ = PROF_THROTTLE_USEC;
+
+  // Whether some calls may go untimed, through sampling or throttling.
+  bool selective_timing_ = false;
+
+  // Region filter, from VERNIER_INCLUDE, VERNIER_EXCLUDE and
+  // VERNIER_FILTER_FILE, and whether any region may be filtered out.
+  RegionFilter region_filter_;
+  bool filtering_ = false;
+
+  // Whether the clock is read only once a call is known to be timed, so that
+  // calls that are not timed, or regions filtered out, read no clock at all.
+  bool deferred_clock_ = false;
+
+  // Number of regions to reserve space for on each thread, from the filter
+  // file if it gives one.
+  std::size_t table_capacity_ = PROF_HASHVEC_RESERVE_SIZE;
+
+  // Maximum number of regions on each thread, from VERNIER_MAX_REGIONS.
+  // Zero means no limit.
+  std::size_t max_regions_ = 0;
+
+  // Number of warm-up calls of each region, from VERNIER_WARMUP_CALLS, and
+  // the number of times the steady state has been marked. Warm-up calls are
+  // reported separately from the other times. Each thread applies a new mark
+  // to its own records, so that no thread writes to another's.
+  unsigned long long int warmup_calls_ = 0;
+  std::atomic<unsigned long> steady_state_epoch_ = 0;
+
+  // Whether regions are profiled by call path, from VERNIER_CALL_TREE, and
+  // the greatest number of regions in a call path, from
+  // VERNIER_CALL_TREE_DEPTH. Deeper regions are profiled by name alone.
+  bool call_tree_ = false;
+  int call_tree_depth_ = PROF_MAX_TRACEBACK_SIZE;
+
   // MPI Context
   MPIContext mpi_context_;
 
-  // Static, threadprivate data members
-  static time_point_t logged_calliper_start_time_;
-  static int call_depth_;
-#pragma omp threadprivate(call_depth_, logged_calliper_start_time_)
+  // Names of pre-registered regions. Not cleared by finalize(), since
+  // handles may be held in static storage by client code.
+  RegionRegistry region_registry_;
+
+  // Per-thread state blocks, indexed by thread ID. Slots for threads that
+  // have not entered a calliper are empty.
+  std::vector<std::unique_ptr<ThreadState>> thread_states_;
+  std::mutex thread_states_mutex_;
+
+  // Incremented by each init() and finalize(), so that threads can tell
+  // whether their thread_local state pointer belongs to the current profile.
+  // Starts ahead of the thread_local copies, which are therefore stale.
+  unsigned long epoch_ = 1;
 
-  // Hashtables and tracebacks
-  std::vector<HashTable> thread_hashtables_;
-  std::vector<std::array<TracebackEntry, PROF_MAX_TRACEBACK_SIZE>>
-      thread_traceback_;
+  // Static, thread-local data members. Defined inline so that the callipers
+  // in vernier_inline.h can access them directly.
+  static inline thread_local ThreadState *thread_state_ = nullptr;
+  static inline thread_local unsigned long thread_state_epoch_ = 0;
 
   // Type definitions for vector array indexing.
-  typedef std::vector<HashTable>::size_type hashtable_iterator_t_;
-  typedef std::vector<std::array<TracebackEntry, PROF_MAX_TRACEBACK_SIZE>>::
-      size_type traceback_index_t;
+  typedef std::vector<std::unique_ptr<ThreadState>>::size_type thread_index_t;
+  typedef std::vector<TracebackEntry>::size_type traceback_index_t;
 
   // Private methods
+  bool disabled() const;
+  bool read_enable_setting() const;
+  ThreadState &this_thread_state();
+  ThreadState &started_thread_state();
+  ThreadState &register_thread();
+  ThreadState &get_thread_state(int const) const;
   void start_part1();
   size_t start_part2(std::string_view const);
+  void resolve_handle(ThreadState &, RegionHandle const, size_t &,
+                      record_index_t &);
+  void report_mismatch(ThreadState const &, size_t const, size_t const) const;
+  void start_record(ThreadState &, size_t const, record_index_t const);
+  void grow_traceback(ThreadState &) const;
+  void stop_record(ThreadState &, size_t const, time_point_t);
+  void stop_untimed(ThreadState &, TracebackEntry const &);
+  void apply_steady_state(ThreadState &) const;
+  CalliperCosts calibrate_callipers();
 
 public:
   // Default constructor needed for `inline` global Vernier object.
@@ -105,10 +272,33 @@ class Vernier {
             std::string_view tag = MPI_CONTEXT_NULL_STRING);
   void finalize();
   size_t start(std::string_view const);
+  size_t start_indexed(std::string_view const, int const);
   void stop(size_t const);
+  void mark_steady_state();
   void write();
+  bool is_enabled() const;
 
-  // Getters
+  // Pre-registered regions
+  RegionHandle register_region(std::string_view const);
+  RegionHandle register_region(std::string_view const, size_t const);
+  void start(RegionHandle const);
+  void stop(RegionHandle const);
+
+  // Callipers tagged with an instrumentation level
+  template <int Level, int MaxLevel = VERNIER_MAX_LEVEL>
+  size_t start(std::string_view const);
+  template <int Level, int MaxLevel = VERNIER_MAX_LEVEL>
+  void stop(size_t const);
+  template <int Level, int MaxLevel = VERNIER_MAX_LEVEL>
+  void start(RegionHandle const);
+  template <int Level, int MaxLevel = VERNIER_MAX_LEVEL>
+  void stop(RegionHandle const);
+
+  // Count-only events
+  void count(std::string_view const, unsigned long long int const = 1);
+  void count(RegionHandle const, unsigned long long int const = 1);
+
+  // Getters, which return zero or an empty name while profiling is disabled
   double get_total_walltime(size_t const, int const);
   double get_overhead_walltime(size_t const, int const);
   double get_self_walltime(size_t const hash, int const input_tid);
@@ -117,15 +307,124 @@ class Vernier {
                                         int const input_tid) const;
   unsigned long long int get_call_count(size_t const hash,
                                         int const input_tid) const;
+  unsigned long long int get_event_count(size_t const hash,
+                                         int const input_tid) const;
   unsigned long long int get_prof_call_count(int const input_tid) const;
 
   // Grant these functions access to private methods.
   void friend c_vernier_start_part1();
-  void friend c_vernier_start_part2(long int &hash_out, char const *name);
+  void friend c_vernier_start_part2(long int *hash_out, char const *name);
 };
 
 // Declare global profiler
 inline Vernier vernier;
 
+/**
+ * @brief  Times a pre-registered region for the lifetime of the object.
+ *
+ * The region is stopped when the enclosing scope is left, whether normally or
+ * by an exception.
+ */
+
+class ScopedRegion {
+private:
+  RegionHandle handle_;
+
+public:
+  // Constructors
+  explicit ScopedRegion(RegionHandle const);
+  ScopedRegion(ScopedRegion const &) = delete;
+  ScopedRegion &operator=(ScopedRegion const &) = delete;
+
+  // Destructor
+  ~ScopedRegion();
+};
+
+/**
+ * @brief  Times a pre-registered region for the lifetime of the object, if its
+ *         instrumentation level is compiled in.
+ * @details The handle is obtained from a callable, which is not called when
+ *          the level is compiled out, so that the region is never registered.
+ */
+
+template <bool Enabled> class LevelScopedRegion : public ScopedRegion {
+public:
+  template <typename GetHandle>
+  explicit LevelScopedRegion(GetHandle const get_handle)
+      : ScopedRegion(get_handle()) {}
+};
+
+template <> class LevelScopedRegion<false> {
+public:
+  template <typename GetHandle> explicit LevelScopedRegion(GetHandle const) {}
+};
+
 } // namespace meto
+
+/**
+ * @brief  Handle for a region named by a string literal.
+ * @details The name is hashed at compile time, and the handle is registered
+ *          once per call site and cached in a function-local static.
+ *          While profiling is disabled, nothing is registered.
+ *          For example:
+ *          @code
+ *            meto::vernier.start(VERNIER_REGION("solver"));
+ *            meto::vernier.stop(VERNIER_REGION("solver"));
+ *          @endcode
+ * @param name  The region name, which must be a string literal.
+ */
+
+#define VERNIER_REGION(name)                                                   \
+  ([]() -> meto::RegionHandle const & {                                        \
+    constexpr std::size_t vernier_region_hash = meto::hash_region_name(name);  \
+    if (!meto::vernier.is_enabled()) {                                         \
+      return meto::unregistered_region_handle;                                 \
+    }                                                                          \
+    static meto::RegionHandle const vernier_region_handle =                    \
+        meto::vernier.register_region(name, vernier_region_hash);              \
+    return vernier_region_handle;                                              \
+  }())
+
+#define VERNIER_CONCAT_IMPL(a, b) a##b
+#define VERNIER_CONCAT(a, b) VERNIER_CONCAT_IMPL(a, b)
+
+/**
+ * @brief  Times the rest of the enclosing scope as a region.
+ * @details For example:
+ *          @code
+ *            void solve() {
+ *              VERNIER_SCOPED_REGION("solver");
+ *              ...
+ *            }
+ *          @endcode
+ * @param name  The region name, which must be a string literal.
+ */
+
+#define VERNIER_SCOPED_REGION(name)                                            \
+  meto::ScopedRegion const VERNIER_CONCAT(vernier_scoped_region_, __LINE__)(   \
+      VERNIER_REGION(name))
+
+/**
+ * @brief  Times the rest of the enclosing scope as a region, if the
+ *         instrumentation level is compiled in.
+ * @details Compiles to nothing when the level exceeds VERNIER_MAX_LEVEL.
+ *          For example:
+ *          @code
+ *            void solve() {
+ *              VERNIER_SCOPED_REGION_LEVEL(2, "solver");
+ *              ...
+ *            }
+ *          @endcode
+ * @param level  The instrumentation level, which must be a constant expression.
+ * @param name   The region name, which must be a string literal.
+ */
+
+#define VERNIER_SCOPED_REGION_LEVEL(level, name)                               \
+  meto::LevelScopedRegion<meto::level_enabled<(level)>> const VERNIER_CONCAT(  \
+      vernier_scoped_region_, __LINE__)(                                       \
+      []() -> meto::RegionHandle const & { return VERNIER_REGION(name); })
+
+// Inline definitions of the callipers.
+#include "vernier_inline.h"
+
 #endif
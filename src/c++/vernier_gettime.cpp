@@ -1,18 +1,171 @@
 /* -----------------------------------------------------------------------------
- *  (c) Crown copyright 2022 Met Office. All rights reserved.
+ *  (c) Crown copyright 2026 Met Office. All rights reserved.
  *  The file LICENCE, distributed with this code, contains details of the terms
  *  under which the code may be used.
  * -----------------------------------------------------------------------------
  */
 
 #include "vernier_gettime.h"
+#include "error_handler.h"
+
+#include <cstdlib>
+#include <iostream>
+
+#ifdef PROF_HAVE_TSC
+#include <cpuid.h>
+#endif
+
+#ifndef PROF_DEFAULT_CLOCK
+#define PROF_DEFAULT_CLOCK "steady"
+#endif
+
+// Length of the TSC calibration interval, in nanoseconds.
+#define PROF_TSC_CALIBRATION_TIME 20000000
+
+/**
+ * @brief  Selects the clock backend, from the VERNIER_CLOCK environment
+ *         variable or else the build-time default.
+ * @note   Falls back to the steady clock, with a warning, if the chosen
+ *         backend is not usable here.
+ */
+
+void meto::init_clock() {
+
+  std::string clock = PROF_DEFAULT_CLOCK;
+
+  char const *env_clock = std::getenv("VERNIER_CLOCK");
+  if (env_clock) {
+    clock = env_clock;
+  }
+
+  ClockSettings settings;
+  settings.type_ = parse_clock_type(clock);
+
+  if (!clock_type_available(settings.type_)) {
+    std::cerr << "Vernier: clock '" << clock
+              << "' is not available. Using the steady clock instead."
+              << std::endl;
+    settings = ClockSettings();
+  } else if (settings.type_ == ClockType::tsc) {
+    settings.seconds_per_tick_ = calibrate_tsc();
+  } else if (settings.type_ != ClockType::steady) {
+    settings.seconds_per_tick_ = 1.0e-9;
+  }
+
+  clock_settings = settings;
+}
+
+/**
+ * @brief  Converts a clock backend name into a clock type.
+ * @param [in] name  The backend name.
+ * @returns  The clock type.
+ */
+
+meto::ClockType meto::parse_clock_type(std::string const &name) {
+  if (name == "steady") {
+    return ClockType::steady;
+  } else if (name == "monotonic_raw") {
+    return ClockType::monotonic_raw;
+  } else if (name == "monotonic_coarse") {
+    return ClockType::monotonic_coarse;
+  } else if (name == "tsc") {
+    return ClockType::tsc;
+  }
+
+  std::string error_msg = "Invalid Vernier clock choice. Expected 'steady', "
+                          "'monotonic_raw', 'monotonic_coarse' or 'tsc'. "
+                          "Currently set to '" +
+                          name + "'.";
+  error_handler(error_msg, EXIT_FAILURE);
+  return ClockType::steady;
+}
+
+/**
+ * @brief  Gets the name of a clock backend.
+ * @param [in] type  The clock type.
+ * @returns  The backend name, as accepted by VERNIER_CLOCK.
+ */
+
+std::string meto::clock_type_name(ClockType const type) {
+  switch (type) {
+  case ClockType::monotonic_raw:
+    return "monotonic_raw";
+  case ClockType::monotonic_coarse:
+    return "monotonic_coarse";
+  case ClockType::tsc:
+    return "tsc";
+  default:
+    return "steady";
+  }
+}
+
+/**
+ * @brief  Checks whether a clock backend can be used on this platform.
+ * @param [in] type  The clock type.
+ * @note   The time stamp counter is only used if it is invariant.
+ */
+
+bool meto::clock_type_available(ClockType const type) {
+  switch (type) {
+  case ClockType::monotonic_raw:
+#ifdef CLOCK_MONOTONIC_RAW
+    return true;
+#else
+    return false;
+#endif
+  case ClockType::monotonic_coarse:
+#ifdef CLOCK_MONOTONIC_COARSE
+    return true;
+#else
+    return false;
+#endif
+  case ClockType::tsc:
+    return tsc_is_invariant();
+  default:
+    return true;
+  }
+}
+
+/**
+ * @brief  Measures the length of a time stamp counter tick against the
+ *         monotonic clock.
+ * @returns  Seconds per tick.
+ * @note   The measurement is made once and reused by subsequent calls.
+ */
+
+double meto::calibrate_tsc() {
+  static double const seconds_per_tick = []() {
+    clock_ticks_t const ns_start = read_posix_clock(CLOCK_MONOTONIC);
+    clock_ticks_t const tsc_start = read_clock_ticks(ClockType::tsc);
+
+    clock_ticks_t ns_end;
+    do {
+      ns_end = read_posix_clock(CLOCK_MONOTONIC);
+    } while (ns_end - ns_start < PROF_TSC_CALIBRATION_TIME);
+    clock_ticks_t const tsc_end = read_clock_ticks(ClockType::tsc);
+
+    return static_cast<double>(ns_end - ns_start) * 1.0e-9 /
+           static_cast<double>(tsc_end - tsc_start);
+  }();
+  return seconds_per_tick;
+}
 
 /**
- * @brief Returns the current time.
- *
- * @returns The present time point.
+ * @brief  Checks whether the CPU has an invariant time stamp counter, which
+ *         ticks at a constant rate regardless of frequency scaling and sleep
+ *         states.
  */
 
-meto::time_point_t meto::vernier_gettime() {
-  return std::chrono::steady_clock::now();
+bool meto::tsc_is_invariant() {
+#ifdef PROF_HAVE_TSC
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 ||
+      eax < 0x80000007) {
+    return false;
+  }
+  __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+  return (edx & (1u << 8)) != 0;
+#else
+  return false;
+#endif
 }
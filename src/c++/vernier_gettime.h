@@ -10,22 +10,128 @@
  * @brief  Declares time-measurement functionality.
  *
  * Contains abstractions for time points, time durations and the clock itself.
+ * Times are measured and accumulated in integer clock ticks, so that long
+ * totals stay exact.
+ * The clock backend is chosen at init() time, from the VERNIER_CLOCK
+ * environment variable or else the build-time default.
  */
 
 #ifndef VERNIER_GETTIME_H
 #define VERNIER_GETTIME_H
 
 #include <chrono>
+#include <cstdint>
+#include <string>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROF_HAVE_TSC
+#endif
 
 namespace meto {
 
-// Type definitions for chrono steady clock time points and durations
-using time_duration_t = std::chrono::duration<double>;
-using time_point_t =
-    std::chrono::time_point<std::chrono::steady_clock, time_duration_t>;
+// Raw clock reading, in backend-specific units.
+using clock_ticks_t = std::int64_t;
+
+// Type definitions for time points and durations. Both are held as integer
+// clock ticks, and only converted to seconds for output.
+using time_duration_t = clock_ticks_t;
+using time_point_t = clock_ticks_t;
+
+/**
+ * @brief  Available clock backends.
+ */
+
+enum class ClockType {
+  steady,           // std::chrono::steady_clock
+  monotonic_raw,    // clock_gettime(CLOCK_MONOTONIC_RAW)
+  monotonic_coarse, // clock_gettime(CLOCK_MONOTONIC_COARSE)
+  tsc               // Time stamp counter, calibrated at init()
+};
+
+/**
+ * @brief  The clock backend in use, and the length of one of its ticks.
+ */
+
+struct ClockSettings {
+  ClockType type_ = ClockType::steady;
+  double seconds_per_tick_ =
+      static_cast<double>(std::chrono::steady_clock::period::num) /
+      static_cast<double>(std::chrono::steady_clock::period::den);
+};
+
+inline ClockSettings clock_settings;
 
 // Function prototypes
-time_point_t vernier_gettime();
+void init_clock();
+ClockType parse_clock_type(std::string const &);
+std::string clock_type_name(ClockType const);
+bool clock_type_available(ClockType const);
+bool tsc_is_invariant();
+double calibrate_tsc();
+
+/**
+ * @brief  Reads a clock_gettime clock.
+ * @param [in] clock_id  The POSIX clock ID.
+ * @returns  The time, in nanoseconds.
+ */
+
+inline clock_ticks_t read_posix_clock(clockid_t const clock_id) {
+  struct timespec point;
+  clock_gettime(clock_id, &point);
+  return clock_ticks_t{point.tv_sec} * 1000000000 +
+         clock_ticks_t{point.tv_nsec};
+}
+
+/**
+ * @brief  Reads the specified clock backend.
+ * @param [in] type  The clock backend.
+ * @returns  The raw clock reading, in ticks of the backend.
+ * @note   Backends that are not available on this platform read the steady
+ *         clock instead. init_clock() never selects them.
+ */
+
+inline clock_ticks_t read_clock_ticks(ClockType const type) {
+  switch (type) {
+#ifdef CLOCK_MONOTONIC_RAW
+  case ClockType::monotonic_raw:
+    return read_posix_clock(CLOCK_MONOTONIC_RAW);
+#endif
+#ifdef CLOCK_MONOTONIC_COARSE
+  case ClockType::monotonic_coarse:
+    return read_posix_clock(CLOCK_MONOTONIC_COARSE);
+#endif
+#ifdef PROF_HAVE_TSC
+  case ClockType::tsc:
+    return static_cast<clock_ticks_t>(__rdtsc());
+#endif
+  default:
+    return clock_ticks_t{
+        std::chrono::steady_clock::now().time_since_epoch().count()};
+  }
+}
+
+/**
+ * @brief Returns the current time.
+ *
+ * @returns The present time point.
+ * @note   Defined inline, since it is called several times by every calliper.
+ */
+
+inline time_point_t vernier_gettime() {
+  return read_clock_ticks(clock_settings.type_);
+}
+
+/**
+ * @brief  Converts a duration in clock ticks into seconds.
+ * @param [in] duration  The duration, in ticks of the current clock backend.
+ * @returns  The duration in seconds.
+ */
+
+inline double ticks_to_seconds(time_duration_t const duration) {
+  return static_cast<double>(duration) * clock_settings.seconds_per_tick_;
+}
 
 } // namespace meto
 #endif
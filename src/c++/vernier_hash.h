@@ -0,0 +1,214 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+/**
+ *  @file   vernier_hash.h
+ *  @brief  Hash function for region names.
+ *
+ *  The hash is constexpr, so that region names given as string literals can be
+ *  hashed at compile time. It reads names in place, so names may be of any
+ *  length, and it does not depend on the thread, so region hashes can be
+ *  compared across threads and MPI ranks.
+ *
+ *  The algorithm follows wyhash: input is consumed in 8-byte words, which are
+ *  mixed by 64x64->128-bit multiplication. Words are assembled little-endian,
+ *  so the hash of a name is the same on every platform.
+ *
+ */
+
+#ifndef VERNIER_HASH_H
+#define VERNIER_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Default seed for region name hashes. Not overridable, so that hashes
+// computed at compile time in client code match those computed at run time
+// in the library.
+#define PROF_HASH_SEED 0
+
+namespace meto {
+
+namespace hash_detail {
+
+// Mixing constants.
+inline constexpr std::uint64_t secret[4] = {
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL,
+    0x4d5a2da51de1aa47ULL};
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+/**
+ * @brief  Multiplies two 64-bit words, giving a 128-bit product.
+ * @param [inout] a  First word on input; low half of the product on output.
+ * @param [inout] b  Second word on input; high half of the product on output.
+ */
+
+constexpr void multiply(std::uint64_t &a, std::uint64_t &b) {
+#ifdef __SIZEOF_INT128__
+  uint128_t const product = static_cast<uint128_t>(a) * b;
+  a = static_cast<std::uint64_t>(product);
+  b = static_cast<std::uint64_t>(product >> 64);
+#else
+  std::uint64_t const a_lo = a & 0xffffffffULL;
+  std::uint64_t const a_hi = a >> 32;
+  std::uint64_t const b_lo = b & 0xffffffffULL;
+  std::uint64_t const b_hi = b >> 32;
+  std::uint64_t const lo_lo = a_lo * b_lo;
+  std::uint64_t const hi_lo = a_hi * b_lo;
+  std::uint64_t const lo_hi = a_lo * b_hi;
+  std::uint64_t const hi_hi = a_hi * b_hi;
+  std::uint64_t const cross = (lo_lo >> 32) + (hi_lo & 0xffffffffULL) + lo_hi;
+  a = (cross << 32) | (lo_lo & 0xffffffffULL);
+  b = hi_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+/**
+ * @brief  Multiplies two 64-bit words, and folds the 128-bit product.
+ * @param [in] a  First word.
+ * @param [in] b  Second word.
+ * @returns  The low and high halves of the product, exclusive-ORed.
+ */
+
+constexpr std::uint64_t mix(std::uint64_t a, std::uint64_t b) {
+  multiply(a, b);
+  return a ^ b;
+}
+
+/**
+ * @brief  Reads bytes from a string as a little-endian word.
+ * @param [in] s       The string.
+ * @param [in] offset  Position of the first byte.
+ * @param [in] count   Number of bytes, at most 8.
+ * @returns  The word.
+ */
+
+constexpr std::uint64_t read_bytes(std::string_view const s,
+                                   std::size_t const offset,
+                                   std::size_t const count) {
+  std::uint64_t word = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    word |= std::uint64_t{static_cast<unsigned char>(s[offset + i])} << (8 * i);
+  }
+  return word;
+}
+
+constexpr std::uint64_t read8(std::string_view const s,
+                              std::size_t const offset) {
+  return read_bytes(s, offset, 8);
+}
+
+constexpr std::uint64_t read4(std::string_view const s,
+                              std::size_t const offset) {
+  return read_bytes(s, offset, 4);
+}
+
+} // namespace hash_detail
+
+/**
+ * @brief  Hashes a region name.
+ * @param [in] region_name  The region name, of any length.
+ * @param [in] seed         Seed for the hash.
+ * @returns  The hash of the region name.
+ */
+
+constexpr std::size_t
+hash_region_name(std::string_view const region_name,
+                 std::uint64_t seed = PROF_HASH_SEED) {
+  using namespace hash_detail;
+
+  std::size_t const len = region_name.size();
+  seed ^= mix(seed ^ secret[0], secret[1]);
+
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+  if (len <= 16) {
+    if (len >= 4) {
+      std::size_t const step = (len >> 3) << 2;
+      a = (read4(region_name, 0) << 32) | read4(region_name, step);
+      b = (read4(region_name, len - 4) << 32) |
+          read4(region_name, len - 4 - step);
+    } else if (len > 0) {
+      a = (std::uint64_t{static_cast<unsigned char>(region_name[0])} << 16) |
+          (std::uint64_t{static_cast<unsigned char>(region_name[len >> 1])}
+           << 8) |
+          std::uint64_t{static_cast<unsigned char>(region_name[len - 1])};
+    }
+  } else {
+    std::size_t pos = 0;
+    std::size_t remaining = len;
+    if (remaining > 48) {
+      std::uint64_t seed1 = seed;
+      std::uint64_t seed2 = seed;
+      do {
+        seed = mix(read8(region_name, pos) ^ secret[1],
+                   read8(region_name, pos + 8) ^ seed);
+        seed1 = mix(read8(region_name, pos + 16) ^ secret[2],
+                    read8(region_name, pos + 24) ^ seed1);
+        seed2 = mix(read8(region_name, pos + 32) ^ secret[3],
+                    read8(region_name, pos + 40) ^ seed2);
+        pos += 48;
+        remaining -= 48;
+      } while (remaining > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (remaining > 16) {
+      seed = mix(read8(region_name, pos) ^ secret[1],
+                 read8(region_name, pos + 8) ^ seed);
+      pos += 16;
+      remaining -= 16;
+    }
+    // The last 16 bytes, which may overlap those already consumed.
+    a = read8(region_name, len - 16);
+    b = read8(region_name, len - 8);
+  }
+
+  // Fold the last words into the state.
+  a ^= secret[1];
+  b ^= seed;
+  multiply(a, b);
+  return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+/**
+ * @brief  Hashes an indexed region, identified by a region name and an
+ *         integer key.
+ * @param [in] name_hash  The hash of the region name, from hash_region_name.
+ * @param [in] key        The key.
+ * @returns  The hash of the indexed region.
+ */
+
+constexpr std::size_t hash_indexed_region(std::size_t const name_hash,
+                                          int const key) {
+  using namespace hash_detail;
+
+  std::uint64_t const key_word = static_cast<std::uint32_t>(key);
+  return mix(name_hash ^ secret[2], key_word ^ secret[3]);
+}
+
+/**
+ * @brief  Hashes a node of the call tree, identified by its parent node and
+ *         its region.
+ * @param [in] parent_hash  The hash of the parent node. For a node at the top
+ *                          of the tree, this is the hash of its region name.
+ * @param [in] region_hash  The hash of the region.
+ * @returns  The hash of the node.
+ */
+
+constexpr std::size_t hash_call_path(std::size_t const parent_hash,
+                                     std::size_t const region_hash) {
+  using namespace hash_detail;
+
+  return mix(parent_hash ^ secret[3], region_hash ^ secret[0]);
+}
+
+} // namespace meto
+
+#endif
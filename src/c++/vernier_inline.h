@@ -0,0 +1,763 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+/**
+ *  @file   vernier_inline.h
+ *  @brief  Inline definitions of the calliper fast path.
+ *
+ *  Included at the end of vernier.h, and not intended to be included directly.
+ *  Defining the callipers here lets the compiler inline the clock reads and
+ *  the traceback push/pop into client code. Work that is only needed the
+ *  first time a region is met, or when an error is detected, stays in the
+ *  library.
+ *
+ */
+
+#ifndef VERNIER_INLINE_H
+#define VERNIER_INLINE_H
+
+#include <cstdlib>
+
+#include "error_handler.h"
+#include "vernier.h"
+
+//------------------------------------------------------------------------------
+// HashTable
+//------------------------------------------------------------------------------
+
+/**
+ * @brief  Looks up the region record for a pre-registered region handle.
+ * @param [in]  handle        The region handle.
+ * @param [out] hash          Hash of the region name.
+ * @param [out] record_index  Array index of the region record.
+ * @returns  True if the handle has already been resolved on this thread.
+ *
+ */
+
+inline bool meto::HashTable::query_handle(RegionHandle const handle,
+                                          size_t &hash,
+                                          record_index_t &record_index) const {
+  if (handle.id_ >= handle_lookup_.size()) {
+    return false;
+  }
+
+  record_index = handle_lookup_[handle.id_];
+  if (record_index == handle_unset_) {
+    return false;
+  }
+
+  hash = hashvec_[record_index].region_hash_;
+  return true;
+}
+
+/**
+ * @brief  Looks up the call-tree node for a region beneath a parent node.
+ * @param [in] parent_index  Array index of the parent node's record.
+ * @param [in] region_index  Array index of the region record.
+ * @returns  Array index of the node's record, which is created if need be.
+ *
+ */
+
+inline meto::record_index_t
+meto::HashTable::query_node(record_index_t const parent_index,
+                            record_index_t const region_index) {
+  if (parent_index < child_caches_.size()) {
+    auto const &entry =
+        child_caches_[parent_index][region_index &
+                                    (PROF_CHILD_CACHE_SIZE - 1)];
+    if (entry.region_index_ == region_index) {
+      return entry.node_index_;
+    }
+  }
+  return insert_node(parent_index, region_index);
+}
+
+/**
+ * @brief  Updates the total walltime and call count for the specified region.
+ * @param [in] record_index  The index in hashvec_ corresponding to the
+ *                           profiled region.
+ * @param [in] time_delta  The time increment to add.
+ * @param [in] nested_calls  The number of calliper pairs nested in this call.
+ */
+
+inline void meto::HashTable::update(record_index_t const record_index,
+                                    time_duration_t const time_delta,
+                                    unsigned long long int const nested_calls) {
+
+  auto &record = hashvec_[record_index];
+
+  // Increment the walltime for this hash entry. If this region has been called
+  // recursively, directly or indirectly, the time goes into a different bucket.
+  if (record.recursion_level_ > 0) {
+    record.recursion_total_walltime_ += time_delta;
+  } else {
+    record.total_walltime_ += time_delta;
+    record.nested_call_count_ += nested_calls;
+  }
+  record.last_walltime_ = time_delta;
+
+  // Update the number of times this region has been called
+  ++record.call_count_;
+  if (record.call_count_ == warmup_calls_) {
+    end_warmup(record);
+  }
+}
+
+/**
+ * @brief  Adds to the number of events counted for a region.
+ * @param [in] record_index  The index corresponding to the region record.
+ * @param [in] count         The number of events.
+ */
+
+inline void meto::HashTable::add_events(record_index_t const record_index,
+                                        unsigned long long int const count) {
+  hashvec_[record_index].event_count_ += count;
+}
+
+/**
+ * @brief  Decides whether to time this call of a region.
+ * @param [in] record_index  The index corresponding to the region record.
+ * @returns  False if the region is throttled. Otherwise, true on the first
+ *           two calls, and on one in every sample_rate_ calls after that.
+ * @note   The first call is usually slowed by cold caches and lazy
+ *         initialisation, so the second is also timed. Untimed calls are then
+ *         never charged the time of the first call.
+ */
+
+inline bool meto::HashTable::time_call(record_index_t const record_index) {
+  auto &record = hashvec_[record_index];
+  if (record.throttled_) {
+    return false;
+  }
+  if (record.sample_countdown_ > 0) {
+    --record.sample_countdown_;
+    return false;
+  }
+  record.sample_countdown_ =
+      record.call_count_ == 0 ? 0 : record.sample_rate_ - 1;
+  return true;
+}
+
+/**
+ * @brief  Counts a call of a region that was not timed.
+ * @param [in] record_index  The index corresponding to the region record.
+ * @param [in] nested_calls  The number of calliper pairs nested in this call.
+ * @returns  The time charged for the call: that of the most recent call if the
+ *           call was sampled out, or none if the region is throttled.
+ */
+
+inline meto::time_duration_t
+meto::HashTable::update_untimed(record_index_t const record_index,
+                                unsigned long long int const nested_calls) {
+  auto &record = hashvec_[record_index];
+  if (record.throttled_) {
+    ++record.call_count_;
+    if (record.call_count_ == warmup_calls_) {
+      end_warmup(record);
+    }
+    return 0;
+  }
+  ++record.untimed_call_count_;
+  auto const time_delta = record.last_walltime_;
+  update(record_index, time_delta, nested_calls);
+  return time_delta;
+}
+
+/**
+ * @brief  Stops timing a region if it has been called often enough, and its
+ *         calls are short enough on average, for the callipers to dominate.
+ * @param [in] record_index  The index corresponding to the region record.
+ */
+
+inline void meto::HashTable::throttle(record_index_t const record_index) {
+  auto &record = hashvec_[record_index];
+  if (throttle_calls_ == 0 || record.call_count_ < throttle_calls_) {
+    return;
+  }
+  auto const walltime =
+      record.total_walltime_ + record.recursion_total_walltime_;
+  if (static_cast<double>(walltime) <
+      throttle_ticks_ * static_cast<double>(record.call_count_)) {
+    record.throttled_ = true;
+  }
+}
+
+/**
+ * @brief  Whether a region is filtered out.
+ * @param [in] record_index  The index corresponding to the region record.
+ */
+
+inline bool
+meto::HashTable::is_filtered(record_index_t const record_index) const {
+  return hashvec_[record_index].filtered_;
+}
+
+/**
+ * @brief  Increments by 1 the recursion level in a region record.
+ * @param [in] record_index  The index corresponding to the region record.
+ */
+
+inline void
+meto::HashTable::increment_recursion_level(record_index_t const record_index) {
+  auto &record = hashvec_[record_index];
+  ++record.recursion_level_;
+}
+
+/**
+ * @brief  Decrements by 1 the recursion level in a region record.
+ * @param [in] record_index  The index corresponding to the region record.
+ */
+
+inline void
+meto::HashTable::decrement_recursion_level(record_index_t const record_index) {
+  auto &record = hashvec_[record_index];
+  --record.recursion_level_;
+}
+
+/**
+ * @brief  Add in time spent calling child regions. Also retuns a pointer
+ *         to the overhead time so that it can be incremented downstream,
+ *         outside this function, with minimal additional overhead.
+ * @param [in]  record_index   The index corresponding to the region record.
+ * @param [in]  time_delta     The time spent in the child region.
+ * @param [out] overhead_time_ptr  Pointer to the profiling overhead time
+ *                                 incurred by calling children of this region.
+ */
+
+inline void meto::HashTable::add_child_time_to_parent(
+    record_index_t const parent_index, time_duration_t const child_walltime,
+    time_duration_t *&overhead_time_ptr) {
+  auto &record = hashvec_[parent_index];
+  record.child_walltime_ += child_walltime;
+  ++record.child_call_count_;
+  overhead_time_ptr = &record.overhead_walltime_;
+}
+
+/**
+ * @brief  Notes that a region has been charged an estimated child time, from
+ *         a child call that was not timed.
+ * @param [in] record_index  The index corresponding to the region record.
+ */
+
+inline void
+meto::HashTable::mark_estimated_child_time(record_index_t const record_index) {
+  hashvec_[record_index].estimated_child_time_ = true;
+}
+
+/**
+ * @brief Increment the number of calls to the profiler callipers. Also returns
+ *        a pointer to the total profiling overhead time so that it can be
+ *        incremented downstream, outside this function, with minimal
+ *        additional overhead.
+ * @param [out] overhead_time_ptr  Pointer to the total profiling overhead time
+ *                                 incurred by calling every set of profiler
+ *                                 calls.
+ */
+
+inline void
+meto::HashTable::add_profiler_call(time_duration_t *&overhead_time_ptr) {
+  auto &record = hashvec_[profiler_index_];
+  ++record.call_count_;
+  overhead_time_ptr = &record.total_walltime_;
+}
+
+//------------------------------------------------------------------------------
+// Vernier
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Constructor for TracebackEntry struct.
+ * @param [in]  record_hash   The hash of the region name.
+ * @param [in]  record_index  The index of the region record.
+ * @param [in]  region_start_time  The clock measurement just before leaving the
+ *                                 start calliper.
+ * @param [in]  calliper_start_time The clock measurement on entry to the start
+ *                                  calliper.
+ * @param [in]  calliper_pairs_start  The number of calliper pairs completed on
+ *                                    this thread so far.
+ * @param [in]  timed  Whether this call of the region is timed.
+ *
+ */
+
+inline meto::Vernier::TracebackEntry::TracebackEntry(
+    size_t record_hash, meto::record_index_t record_index,
+    meto::time_point_t region_start_time,
+    meto::time_point_t calliper_start_time,
+    unsigned long long int calliper_pairs_start, bool timed)
+    : record_hash_(record_hash), record_index_(record_index),
+      region_start_time_(region_start_time),
+      calliper_start_time_(calliper_start_time),
+      calliper_pairs_start_(calliper_pairs_start), timed_(timed) {}
+
+/**
+ * @brief  Get the profiler state of the calling thread.
+ * @returns  Reference to the calling thread's state block, which is registered
+ *           on the thread's first calliper after each init().
+ */
+
+inline meto::Vernier::ThreadState &meto::Vernier::this_thread_state() {
+  if (thread_state_epoch_ != epoch_) {
+    return register_thread();
+  }
+  return *thread_state_;
+}
+
+/**
+ * @brief  Get the profiler state of the calling thread, which must already
+ *         have started a region.
+ * @returns  Reference to the calling thread's state block.
+ */
+
+inline meto::Vernier::ThreadState &meto::Vernier::started_thread_state() {
+  if (thread_state_epoch_ != epoch_) {
+    error_handler("EMERGENCY STOP: stop called before start calliper.",
+                  EXIT_FAILURE);
+  }
+  return *thread_state_;
+}
+
+/**
+ * @brief   Whether profiling is disabled, the guard at every entry point.
+ * @details Once VERNIER_ENABLE has been read, profiling that is enabled costs
+ *          a single test. The variable is read here if neither init() nor
+ *          an earlier entry point has done so yet.
+ */
+
+inline bool meto::Vernier::disabled() const {
+  auto const state = enable_state_.load(std::memory_order_relaxed);
+  if (state == EnableState::enabled) {
+    return false;
+  }
+  return state == EnableState::disabled || read_enable_setting();
+}
+
+/**
+ * @brief  Whether profiling is enabled, as set by VERNIER_ENABLE.
+ */
+
+inline bool meto::Vernier::is_enabled() const { return !disabled(); }
+
+/**
+ * @brief  Start timing a profiled code region, part 1 of 2: make a
+ *         threadprivate note of the time.
+ */
+
+inline void meto::Vernier::start_part1() {
+
+  // Check that Vernier has been initialised
+  if (!initialized_) {
+    meto::error_handler("Vernier::start_part1. Vernier not initialised.",
+                        EXIT_FAILURE);
+  }
+
+  // Store the calliper start time, which is used in part2. Lean callipers,
+  // and those that only read the clock once a call is known to be timed,
+  // skip this clock read.
+  auto &state = this_thread_state();
+  if (calliper_mode_ == CalliperMode::full && !deferred_clock_) {
+    state.logged_calliper_start_time_ = vernier_gettime();
+  }
+}
+
+/**
+ * @brief   Start timing a pre-registered code region.
+ * @details The first call on each thread resolves the handle into a region
+ *          record; subsequent calls index the record directly.
+ * @param [in]  handle   Handle returned by register_region.
+ */
+
+inline void meto::Vernier::start(RegionHandle const handle) {
+  if (disabled()) {
+    return;
+  }
+
+  start_part1();
+
+  // The calling thread was registered, if need be, by start_part1.
+  auto &state = *thread_state_;
+
+  size_t hash = 0;
+  record_index_t record_index = 0;
+  if (!state.table_.query_handle(handle, hash, record_index)) {
+    resolve_handle(state, handle, hash, record_index);
+  }
+  start_record(state, hash, record_index);
+}
+
+/**
+ * @brief  Push a region onto the traceback, having resolved its record.
+ * @param [in]  state         The calling thread's state.
+ * @param [in]  hash          Hash of the region name.
+ * @param [in]  record_index  Array index of the region record.
+ */
+
+inline void meto::Vernier::start_record(ThreadState &state, size_t const hash,
+                                        record_index_t record_index) {
+
+  // Filtered regions are not put on the traceback, so that their children
+  // are attributed to the nearest region that is profiled.
+  if (filtering_ && state.table_.is_filtered(record_index)) {
+    return;
+  }
+
+  // In call-tree mode, a region beneath another is timed in the node for its
+  // call path, up to the depth limit. The traceback keeps the region's hash,
+  // so that stop callipers still match it.
+  if (call_tree_ && state.call_depth_ >= 0 &&
+      state.call_depth_ + 1 < call_tree_depth_) {
+    auto parent_depth = static_cast<traceback_index_t>(state.call_depth_);
+    record_index = state.table_.query_node(
+        state.traceback_[parent_depth].record_index_, record_index);
+  }
+
+  state.table_.increment_recursion_level(record_index);
+
+  // Make room on the traceback, if need be.
+  ++state.call_depth_;
+  auto call_depth_index = static_cast<traceback_index_t>(state.call_depth_);
+  if (call_depth_index >= state.traceback_.size()) {
+    grow_traceback(state);
+  }
+
+  // Store the calliper and region start times. Calls that are sampled out or
+  // throttled are not timed at all. When the clock read is deferred until
+  // now, the callipers of timed calls time only the stop calliper.
+  if (deferred_clock_) {
+    bool const timed =
+        !selective_timing_ || state.table_.time_call(record_index);
+    auto const region_start_time = timed ? vernier_gettime() : time_point_t{0};
+    state.traceback_[call_depth_index] =
+        TracebackEntry(hash, record_index, region_start_time,
+                       region_start_time, state.calliper_pairs_, timed);
+    return;
+  }
+
+  auto region_start_time = vernier_gettime();
+  state.traceback_[call_depth_index] =
+      TracebackEntry(hash, record_index, region_start_time,
+                     state.logged_calliper_start_time_, state.calliper_pairs_,
+                     true);
+}
+
+/**
+ * @brief  Stop timing a profiled code region.
+ * @param [in] hash   Hash of the profiled code region being stopped.
+ * @note  The calliper time (spent in the profiler) is measured by
+ *        differencing the beginning of the start calliper from the end of the
+ *        stop calliper, and subtracting the measured region time. Hence larger
+ *        absolute times are being measured, which are less likely to suffer
+ *        fractional error from precision limitations of the clock. In lean
+ *        mode, the calliper time is instead the calibrated cost of a pair.
+ *        When calls may go untimed, or regions may be filtered out, only the
+ *        stop calliper of a timed call is timed.
+ */
+
+inline void meto::Vernier::stop(size_t const hash) {
+  if (disabled()) {
+    return;
+  }
+
+  // Log the region stop time. When calls may go untimed, or regions may be
+  // filtered out, the clock is not read until the call is known to be timed.
+  auto region_stop_time =
+      deferred_clock_ ? time_point_t{0} : vernier_gettime();
+
+  stop_record(started_thread_state(), hash, region_stop_time);
+}
+
+/**
+ * @brief  Stop timing a pre-registered code region.
+ * @param [in] handle   Handle of the profiled code region being stopped.
+ */
+
+inline void meto::Vernier::stop(RegionHandle const handle) {
+  if (disabled()) {
+    return;
+  }
+
+  // Log the region stop time. When calls may go untimed, or regions may be
+  // filtered out, the clock is not read until the call is known to be timed.
+  auto region_stop_time =
+      deferred_clock_ ? time_point_t{0} : vernier_gettime();
+
+  auto &state = started_thread_state();
+
+  // A handle that has not been started on this thread cannot be stopped.
+  size_t hash = 0;
+  record_index_t record_index = 0;
+  if (!state.table_.query_handle(handle, hash, record_index)) {
+    error_handler("EMERGENCY STOP: stop called with a region handle that was "
+                  "not started on this thread.",
+                  EXIT_FAILURE);
+  }
+
+  stop_record(state, hash, region_stop_time);
+}
+
+/**
+ * @brief  Pop a region from the traceback and accumulate its times.
+ * @param [in] state             The calling thread's state.
+ * @param [in] hash              Hash of the region being stopped.
+ * @param [in] region_stop_time  Clock measurement on entry to the stop
+ *                               calliper. Unset when the clock read is
+ *                               deferred.
+ */
+
+inline void meto::Vernier::stop_record(ThreadState &state, size_t const hash,
+                                       time_point_t region_stop_time) {
+
+  // Filtered regions were never put on the traceback, so their stops do not
+  // match it. This is only checked when the traceback does not match.
+
+  // Check that we have called a start calliper before the stop calliper.
+  // If not, then the call depth would be -1.
+  if (state.call_depth_ < 0) {
+    if (filtering_ && state.table_.find_filtered(hash)) {
+      return;
+    }
+    error_handler("EMERGENCY STOP: stop called before start calliper.",
+                  EXIT_FAILURE);
+  }
+
+  // Get reference to the traceback entry.
+  auto call_depth_index = static_cast<traceback_index_t>(state.call_depth_);
+  auto &traceback_entry = state.traceback_[call_depth_index];
+
+  // Check: which hash is last on the traceback list?
+  if (hash != traceback_entry.record_hash_) {
+    if (filtering_ && state.table_.find_filtered(hash)) {
+      return;
+    }
+    report_mismatch(state, traceback_entry.record_hash_, hash);
+  }
+
+  // Split off the warm-up before this call is added, if the steady state has
+  // been marked since this thread last stopped a region.
+  apply_steady_state(state);
+
+  if (deferred_clock_) {
+    if (!traceback_entry.timed_) {
+      stop_untimed(state, traceback_entry);
+      return;
+    }
+    region_stop_time = vernier_gettime();
+  }
+
+  // Compute the region time
+  auto region_duration = region_stop_time - traceback_entry.region_start_time_;
+
+  // Do the hashtable update for the child region.
+  auto &table = state.table_;
+  table.decrement_recursion_level(traceback_entry.record_index_);
+  table.update(traceback_entry.record_index_, region_duration,
+               state.calliper_pairs_ - traceback_entry.calliper_pairs_start_);
+  ++state.calliper_pairs_;
+  if (selective_timing_) {
+    table.throttle(traceback_entry.record_index_);
+  }
+
+  // Precompute times as far as possible. We just need the calliper stop time
+  // later.
+  //   (t4-t1) = calliper time + region duration
+  //   (t3-t2) = region_duration
+  //   calliper_time = (t4-t1) - (t3-t2)  = t4 - ( t3-t2 + t1)
+  auto temp_sum = traceback_entry.calliper_start_time_ + region_duration;
+
+  // The sequence of code that follows is aimed at leaving only minimal and
+  // simple operations after the call to vernier_gettime().
+  time_duration_t *parent_overhead_time_ptr = nullptr;
+  time_duration_t *profiler_overhead_time_ptr = nullptr;
+
+  // Acquire parent pointers
+  if (state.call_depth_ > 0) {
+    auto parent_depth = static_cast<traceback_index_t>(state.call_depth_ - 1);
+    record_index_t parent_index = state.traceback_[parent_depth].record_index_;
+    table.add_child_time_to_parent(parent_index, region_duration,
+                                   parent_overhead_time_ptr);
+  }
+
+  // Increment profiler calls, and get a pointer to the total overhead time.
+  table.add_profiler_call(profiler_overhead_time_ptr);
+
+  // Decrement index to last entry in the traceback.
+  --state.call_depth_;
+
+  // Account for time spent in the profiler itself. Lean callipers use the
+  // calibrated cost instead of reading the clock again.
+  time_duration_t calliper_time = state.lean_calliper_cost_;
+  if (calliper_mode_ == CalliperMode::full) {
+    calliper_time = vernier_gettime() - temp_sum;
+  }
+
+  // Increment the overhead time specific to this region, incurred when calling
+  // direct children, and also the overall profiling overhead time.
+  // Being outside the stop calliper, these operations need to be as cheap
+  // as possible.
+  if (parent_overhead_time_ptr) {
+    *parent_overhead_time_ptr += calliper_time;
+  }
+  *profiler_overhead_time_ptr += calliper_time;
+}
+
+/**
+ * @brief  Applies the latest steady-state mark to a thread's records, if it
+ *         has not been applied already.
+ * @param [in] state  The state of the calling thread, or of a thread that is
+ *                    not running callipers.
+ */
+
+inline void meto::Vernier::apply_steady_state(ThreadState &state) const {
+  auto const epoch = steady_state_epoch_.load(std::memory_order_relaxed);
+  if (state.steady_state_epoch_ != epoch) {
+    state.steady_state_epoch_ = epoch;
+    state.table_.mark_steady_state();
+  }
+}
+
+/**
+ * @brief  Pop a region that was sampled out from the traceback, charging it
+ *         the duration of its most recent call.
+ * @param [in] state            The calling thread's state.
+ * @param [in] traceback_entry  The region's traceback entry.
+ * @note  No clock is read, so no overhead is recorded. The cost of these
+ *        callipers falls in the parent's self time.
+ */
+
+inline void meto::Vernier::stop_untimed(ThreadState &state,
+                                        TracebackEntry const &traceback_entry) {
+  auto &table = state.table_;
+  table.decrement_recursion_level(traceback_entry.record_index_);
+  auto const region_duration = table.update_untimed(
+      traceback_entry.record_index_,
+      state.calliper_pairs_ - traceback_entry.calliper_pairs_start_);
+  ++state.calliper_pairs_;
+
+  // The parent's self time now depends on an estimated child time. Throttled
+  // calls charge none, so their time simply stays in the parent.
+  time_duration_t *overhead_time_ptr = nullptr;
+  if (state.call_depth_ > 0) {
+    auto parent_depth = static_cast<traceback_index_t>(state.call_depth_ - 1);
+    auto const parent_index = state.traceback_[parent_depth].record_index_;
+    table.add_child_time_to_parent(parent_index, region_duration,
+                                   overhead_time_ptr);
+    if (region_duration > 0) {
+      table.mark_estimated_child_time(parent_index);
+    }
+  }
+  table.add_profiler_call(overhead_time_ptr);
+
+  --state.call_depth_;
+}
+
+//------------------------------------------------------------------------------
+// Callipers tagged with an instrumentation level
+//------------------------------------------------------------------------------
+
+/**
+ * @brief  Start timing a region tagged with an instrumentation level.
+ * @param [in] region_name  The region name.
+ * @returns  The hash of the region name, or 0 if the level is compiled out.
+ */
+
+template <int Level, int MaxLevel>
+inline size_t meto::Vernier::start(
+    [[maybe_unused]] std::string_view const region_name) {
+  if constexpr (level_enabled<Level, MaxLevel>) {
+    return start(region_name);
+  } else {
+    return 0;
+  }
+}
+
+/**
+ * @brief  Stop timing a region tagged with an instrumentation level.
+ * @param [in] hash  Hash returned by the matching start calliper.
+ */
+
+template <int Level, int MaxLevel>
+inline void meto::Vernier::stop([[maybe_unused]] size_t const hash) {
+  if constexpr (level_enabled<Level, MaxLevel>) {
+    stop(hash);
+  }
+}
+
+/**
+ * @brief  Start timing a pre-registered region tagged with an instrumentation
+ *         level.
+ * @param [in] handle  Handle returned by register_region.
+ */
+
+template <int Level, int MaxLevel>
+inline void meto::Vernier::start([[maybe_unused]] RegionHandle const handle) {
+  if constexpr (level_enabled<Level, MaxLevel>) {
+    start(handle);
+  }
+}
+
+/**
+ * @brief  Stop timing a pre-registered region tagged with an instrumentation
+ *         level.
+ * @param [in] handle  Handle returned by register_region.
+ */
+
+template <int Level, int MaxLevel>
+inline void meto::Vernier::stop([[maybe_unused]] RegionHandle const handle) {
+  if constexpr (level_enabled<Level, MaxLevel>) {
+    stop(handle);
+  }
+}
+
+/**
+ * @brief  Count events against a pre-registered region, without timing.
+ * @param [in] handle  Handle returned by register_region.
+ * @param [in] count   The number of events.
+ * @note  No clock is read and the traceback is not touched, so this may be
+ *        called anywhere, including outside any region.
+ */
+
+inline void meto::Vernier::count(RegionHandle const handle,
+                                 unsigned long long int const count) {
+  if (disabled()) {
+    return;
+  }
+
+  if (!initialized_) {
+    meto::error_handler("Vernier::count. Vernier not initialised.",
+                        EXIT_FAILURE);
+  }
+
+  auto &state = this_thread_state();
+
+  size_t hash = 0;
+  record_index_t record_index = 0;
+  if (!state.table_.query_handle(handle, hash, record_index)) {
+    resolve_handle(state, handle, hash, record_index);
+  }
+  state.table_.add_events(record_index, count);
+}
+
+//------------------------------------------------------------------------------
+// ScopedRegion
+//------------------------------------------------------------------------------
+
+/**
+ * @brief  Starts a pre-registered region on construction and stops it on
+ *         destruction.
+ * @param [in] handle  Handle of the region to time.
+ */
+
+inline meto::ScopedRegion::ScopedRegion(RegionHandle const handle)
+    : handle_(handle) {
+  vernier.start(handle_);
+}
+
+/**
+ * @brief  Stops the region, including when the scope is left by an exception.
+ */
+
+inline meto::ScopedRegion::~ScopedRegion() { vernier.stop(handle_); }
+
+#endif
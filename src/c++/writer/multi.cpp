@@ -35,16 +35,17 @@ void meto::Multi::open_files() {
  *         strategy.
  *
  * @param[in] hashvec  The vector containing all necessary data
+ * @param[in] notes    Notes on how the profile was taken
  */
 
-void meto::Multi::write(hashvec_t hashvec) {
+void meto::Multi::write(hashvec_t hashvec, profile_notes_t const &notes) {
 
   // Write data into buffers
   std::ostringstream header_buffer;
   std::ostringstream data_buffer;
   rank_info(data_buffer, mpi_context_);
   header(header_buffer, formatter_.get_format_string());
-  formatter_.execute_format(header_buffer, data_buffer, hashvec);
+  formatter_.execute_format(header_buffer, data_buffer, hashvec, notes);
 
   // Open file and write buffers
   open_files();
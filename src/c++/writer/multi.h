@@ -38,7 +38,7 @@ class Multi : public Writer {
   Multi(MPIContext const &);
 
   // Implementation of pure virtual function.
-  void write(hashvec_t) override;
+  void write(hashvec_t, profile_notes_t const &) override;
 };
 
 } // namespace meto
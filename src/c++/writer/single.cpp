@@ -22,8 +22,9 @@ meto::SingleFile::SingleFile(MPIContext const &mpi_context)
  * @brief  The main write method.
  *
  * @param[in] hashvec  The vector containing all necessary data
+ * @param[in] notes    Notes on how the profile was taken
  */
-void meto::SingleFile::write(hashvec_t hashvec) {
+void meto::SingleFile::write(hashvec_t hashvec, profile_notes_t const &notes) {
   /* This is a complete cheat for now: ignore the ofstream and do
    * everything through MPI IO.
    */
@@ -35,7 +36,7 @@ void meto::SingleFile::write(hashvec_t hashvec) {
   header(header_buffer, formatter_.get_format_string());
 
   // Format the report on each task and buffer it on each task
-  formatter_.execute_format(header_buffer, data_buffer, hashvec);
+  formatter_.execute_format(header_buffer, data_buffer, hashvec, notes);
 
   std::string filename = output_filename_ + mpi_filename_tail;
 
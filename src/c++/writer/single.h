@@ -30,7 +30,7 @@ namespace meto {
 class SingleFile : public Writer {
 public:
   SingleFile(MPIContext const &);
-  void write(hashvec_t) override;
+  void write(hashvec_t, profile_notes_t const &) override;
 };
 
 } // namespace meto
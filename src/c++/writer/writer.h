@@ -43,7 +43,7 @@ class Writer {
   virtual ~Writer() = default;
 
   // Pure virtual write method
-  virtual void write(hashvec_t) = 0;
+  virtual void write(hashvec_t, profile_notes_t const &) = 0;
 };
 
 } // namespace meto
@@ -11,28 +11,18 @@
  * Neither Fortran or C can interface with C++ object constructs. Hence
  * C-language interfaces are needed to call Vernier from C and Fortran.
  *
- * Since Fortran is pass by reference, arguments are received as references (&).
+ * Since Fortran is pass by reference, arguments are received as pointers,
+ * as declared in vernier_c.h.
  *
  */
 
+#include "vernier_c.h"
 #include "vernier.h"
 #include "vernier_get_wtime.h"
 #include "vernier_mpi.h"
 #include <cstring>
 #include <string>
 
-extern "C" {
-void c_vernier_init(const MPI_Fint *const client_comm_handle,
-                    const char *const tag);
-void c_vernier_finalize();
-void c_vernier_start_part1();
-void c_vernier_start_part2(long int &, char const *);
-void c_vernier_stop(long int const &);
-void c_vernier_write();
-double c_vernier_get_total_walltime(long int const &, int const &);
-double c_vernier_get_wtime();
-}
-
 /**
  * @brief  Set a client-code-defined MPI communicator handle.
  * @details May be used to set other values in future, too.
@@ -66,7 +56,11 @@ void c_vernier_finalize() { meto::vernier.finalize(); }
  * @brief  Start timing, part 1 of 2.
  */
 
-void meto::c_vernier_start_part1() { meto::vernier.start_part1(); }
+void meto::c_vernier_start_part1() {
+  if (!meto::vernier.disabled()) {
+    meto::vernier.start_part1();
+  }
+}
 
 /**
  * @brief  Start timing, part 2 of 2. a named region and return a unique handle.
@@ -74,28 +68,128 @@ void meto::c_vernier_start_part1() { meto::vernier.start_part1(); }
  * @param [out]  hash_out  The returned unique hash for this region.
  */
 
-void meto::c_vernier_start_part2(long int &hash_out, char const *name) {
-  size_t hash = meto::vernier.start_part2(name);
+void meto::c_vernier_start_part2(long int *hash_out, char const *name) {
+  size_t hash =
+      meto::vernier.disabled() ? size_t{0} : meto::vernier.start_part2(name);
 
   // Ensure that the source and destination have the same size.
+  static_assert(sizeof(hash) == sizeof(*hash_out), "Hash/Out size mismatch.");
+  std::memcpy(hash_out, &hash, sizeof(hash));
+}
+
+/**
+ * @brief  Start timing a named region, whose name is not null terminated.
+ * @param [in]  name    The region name.
+ * @param [in]  length  The number of characters in the region name.
+ * @returns  The unique hash for this region.
+ * @note  Both arguments are passed by value, so this function may be called
+ *        directly from C. Fortran callers can pass a blank-trimmed length
+ *        without copying the name into a null-terminated buffer.
+ */
+
+long int c_vernier_start_n(char const *name, size_t length) {
+  size_t hash = meto::vernier.start(std::string_view(name, length));
+
+  long int hash_out;
+  static_assert(sizeof(hash) == sizeof(hash_out), "Hash/Out size mismatch.");
+  std::memcpy(&hash_out, &hash, sizeof(hash));
+  return hash_out;
+}
+
+/**
+ * @brief  Start timing an indexed region, whose name is not null terminated.
+ * @param [in]  name    The region name.
+ * @param [in]  length  The number of characters in the region name.
+ * @param [in]  key     The key, such as a level or iteration number.
+ * @returns  The unique hash for this region and key.
+ * @note  Arguments are passed by value, as for c_vernier_start_n.
+ */
+
+long int c_vernier_start_indexed_n(char const *name, size_t length, int key) {
+  size_t hash =
+      meto::vernier.start_indexed(std::string_view(name, length), key);
+
+  long int hash_out;
   static_assert(sizeof(hash) == sizeof(hash_out), "Hash/Out size mismatch.");
   std::memcpy(&hash_out, &hash, sizeof(hash));
+  return hash_out;
 }
 
 /**
  * @brief  Stop timing the region with the specified handle.
  */
 
-void c_vernier_stop(long int const &hash_in) {
+void c_vernier_stop(long int const *hash_in) {
   size_t hash;
 
   // Ensure that the source and destination have the same size.
-  static_assert(sizeof(hash) == sizeof(hash_in), "Hash/In size mismatch.");
-  std::memcpy(&hash, &hash_in, sizeof(hash));
+  static_assert(sizeof(hash) == sizeof(*hash_in), "Hash/In size mismatch.");
+  std::memcpy(&hash, hash_in, sizeof(hash));
 
   meto::vernier.stop(hash);
 }
 
+/**
+ * @brief  Register a region name, returning a handle that can be used to start
+ *         and stop the region without hashing its name.
+ * @param [out]  handle_out  The returned region handle.
+ * @param [in]   name        The region name, null terminated.
+ */
+
+void c_vernier_register_region(long int *handle_out, char const *name) {
+  auto handle = meto::vernier.register_region(name);
+  *handle_out = static_cast<long int>(handle.id_);
+}
+
+/**
+ * @brief  Start timing the region with the specified pre-registered handle.
+ * @param [in]  handle_in  The region handle.
+ */
+
+void c_vernier_start_handle(long int const *handle_in) {
+  meto::vernier.start(meto::RegionHandle(static_cast<size_t>(*handle_in)));
+}
+
+/**
+ * @brief  Stop timing the region with the specified pre-registered handle.
+ * @param [in]  handle_in  The region handle.
+ */
+
+void c_vernier_stop_handle(long int const *handle_in) {
+  meto::vernier.stop(meto::RegionHandle(static_cast<size_t>(*handle_in)));
+}
+
+/**
+ * @brief  Count events against a named region, whose name is not null
+ *         terminated, without timing.
+ * @param [in]  name    The region name.
+ * @param [in]  length  The number of characters in the region name.
+ * @param [in]  count   The number of events.
+ * @note  Arguments are passed by value, as for c_vernier_start_n.
+ */
+
+void c_vernier_count_n(char const *name, size_t length, long int count) {
+  meto::vernier.count(std::string_view(name, length),
+                      static_cast<unsigned long long int>(count));
+}
+
+/**
+ * @brief  Count events against a pre-registered region, without timing.
+ * @param [in]  handle_in  The region handle.
+ * @param [in]  count      The number of events.
+ */
+
+void c_vernier_count_handle(long int const *handle_in, long int const *count) {
+  meto::vernier.count(meto::RegionHandle(static_cast<size_t>(*handle_in)),
+                      static_cast<unsigned long long int>(*count));
+}
+
+/**
+ * @brief Mark the end of the warm-up.
+ */
+
+void c_vernier_mark_steady_state() { meto::vernier.mark_steady_state(); }
+
 /**
  * @brief Write the profile itself.
  */
@@ -109,15 +203,15 @@ void c_vernier_write() { meto::vernier.write(); }
  * @param[in] thread_id   Return the time for this thread ID.
  */
 
-double c_vernier_get_total_walltime(long int const &hash_in,
-                                    int const &thread_id) {
+double c_vernier_get_total_walltime(long int const *hash_in,
+                                    int const *thread_id) {
   size_t hash;
 
   // Ensure that the source and destination have the same size.
-  static_assert(sizeof(hash) == sizeof(hash_in), "Hash/In size mismatch.");
-  std::memcpy(&hash, &hash_in, sizeof(hash));
+  static_assert(sizeof(hash) == sizeof(*hash_in), "Hash/In size mismatch.");
+  std::memcpy(&hash, hash_in, sizeof(hash));
 
-  return meto::vernier.get_total_walltime(hash, thread_id);
+  return meto::vernier.get_total_walltime(hash, *thread_id);
 }
 
 /**
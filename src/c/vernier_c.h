@@ -0,0 +1,103 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+/**
+ * @file   vernier_c.h
+ * @brief  C-language calliper interfaces, and callipers tagged with an
+ *         instrumentation level.
+ *
+ * Declares every interface defined in vernier_c.cpp, which includes this
+ * header so that the declarations are checked against the definitions.
+ * Arguments that Fortran passes by reference are received as pointers.
+ *
+ * Callipers tagged with a level above VERNIER_MAX_LEVEL compile to nothing.
+ * For example:
+ * @code
+ *   long int hash = VERNIER_START_LEVEL(2, "solver");
+ *   ...
+ *   VERNIER_STOP_LEVEL(2, hash);
+ * @endcode
+ *
+ */
+
+#ifndef VERNIER_C_H
+#define VERNIER_C_H
+
+#include <limits.h>
+#include <stddef.h>
+#include <string.h>
+
+// Highest instrumentation level compiled in. By default, every level is kept.
+#ifndef VERNIER_MAX_LEVEL
+#define VERNIER_MAX_LEVEL INT_MAX
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The communicator handle is a Fortran handle, of type MPI_Fint, which is an
+// int. It may be null, for MPI_COMM_WORLD, as may the tag.
+void c_vernier_init(int const *, char const *);
+void c_vernier_finalize(void);
+void c_vernier_start_part1(void);
+void c_vernier_start_part2(long int *, char const *);
+long int c_vernier_start_n(char const *, size_t);
+long int c_vernier_start_indexed_n(char const *, size_t, int);
+void c_vernier_stop(long int const *);
+void c_vernier_register_region(long int *, char const *);
+void c_vernier_start_handle(long int const *);
+void c_vernier_stop_handle(long int const *);
+void c_vernier_count_n(char const *, size_t, long int);
+void c_vernier_count_handle(long int const *, long int const *);
+void c_vernier_mark_steady_state(void);
+void c_vernier_write(void);
+double c_vernier_get_total_walltime(long int const *, int const *);
+double c_vernier_get_wtime(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @brief  Start timing a region, if its level is compiled in.
+ * @param level  The instrumentation level, a constant expression.
+ * @param name   The region name, null terminated.
+ * @returns  The hash of the region name, or 0 if the level is compiled out.
+ */
+
+#define VERNIER_START_LEVEL(level, name)                                       \
+  ((level) <= VERNIER_MAX_LEVEL ? c_vernier_start_n((name), strlen(name))     \
+                                : 0L)
+
+/**
+ * @brief  Stop timing a region, if its level is compiled in.
+ * @param level  The instrumentation level, a constant expression.
+ * @param hash   The hash returned by VERNIER_START_LEVEL.
+ */
+
+#define VERNIER_STOP_LEVEL(level, hash)                                        \
+  ((level) <= VERNIER_MAX_LEVEL ? c_vernier_stop(&(hash)) : (void)0)
+
+/**
+ * @brief  Start timing a pre-registered region, if its level is compiled in.
+ * @param level   The instrumentation level, a constant expression.
+ * @param handle  The handle returned by c_vernier_register_region.
+ */
+
+#define VERNIER_START_HANDLE_LEVEL(level, handle)                              \
+  ((level) <= VERNIER_MAX_LEVEL ? c_vernier_start_handle(&(handle)) : (void)0)
+
+/**
+ * @brief  Stop timing a pre-registered region, if its level is compiled in.
+ * @param level   The instrumentation level, a constant expression.
+ * @param handle  The handle returned by c_vernier_register_region.
+ */
+
+#define VERNIER_STOP_HANDLE_LEVEL(level, handle)                               \
+  ((level) <= VERNIER_MAX_LEVEL ? c_vernier_stop_handle(&(handle)) : (void)0)
+
+#endif
@@ -0,0 +1,40 @@
+! ------------------------------------------------------------------------------
+!  (c) Crown copyright 2026 Met Office. All rights reserved.
+!  The file LICENCE, distributed with this code, contains details of the terms
+!  under which the code may be used.
+! ------------------------------------------------------------------------------
+!> @file    vernier_levels.h
+!> @brief   Callipers tagged with an instrumentation level.
+!> @details Include with the preprocessor, after using vernier_mod. Callipers
+!>          tagged with a level above VERNIER_MAX_LEVEL compile to a branch
+!>          on a constant, which the compiler removes. For example:
+!>
+!>            #include "vernier_levels.h"
+!>            ...
+!>            VERNIER_START_LEVEL(2, hash, "solver")
+!>            ...
+!>            VERNIER_STOP_LEVEL(2, hash)
+!>
+!>          Each calliper expands to a single line, since the preprocessor
+!>          cannot continue it with '&'. Without VERNIER_MAX_LEVEL the line
+!>          is a plain call, shorter than the macro. With it, the line is an
+!>          if statement 6 characters longer than the macro, plus the digits
+!>          of VERNIER_MAX_LEVEL, so calliper lines need that much room below
+!>          the 132-column limit.
+
+#ifdef VERNIER_MAX_LEVEL
+#define VERNIER_START_LEVEL(level, hash, name) \
+  if (level<=VERNIER_MAX_LEVEL) call vernier_start(hash, name)
+#define VERNIER_STOP_LEVEL(level, hash) \
+  if (level<=VERNIER_MAX_LEVEL) call vernier_stop(hash)
+#define VERNIER_START_HANDLE_LEVEL(level, handle) \
+  if (level<=VERNIER_MAX_LEVEL) call vernier_start_handle(handle)
+#define VERNIER_STOP_HANDLE_LEVEL(level, handle) \
+  if (level<=VERNIER_MAX_LEVEL) call vernier_stop_handle(handle)
+#else
+#define VERNIER_START_LEVEL(level, hash, name) call vernier_start(hash, name)
+#define VERNIER_STOP_LEVEL(level, hash) call vernier_stop(hash)
+#define VERNIER_START_HANDLE_LEVEL(level, handle) \
+  call vernier_start_handle(handle)
+#define VERNIER_STOP_HANDLE_LEVEL(level, handle) call vernier_stop_handle(handle)
+#endif
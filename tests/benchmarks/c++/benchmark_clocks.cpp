@@ -0,0 +1,72 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+//
+//  Compares the per-read cost and the resolution of each clock backend.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+#include "vernier_gettime.h"
+
+int main() {
+
+  constexpr int num_reads = 10000000;
+
+  std::cout << std::left << std::setw(20) << "Clock" << std::right
+            << std::setw(16) << "Cost (ns)" << std::setw(20)
+            << "Resolution (ns)" << "\n";
+
+  for (auto const type :
+       {meto::ClockType::steady, meto::ClockType::monotonic_raw,
+        meto::ClockType::monotonic_coarse, meto::ClockType::tsc}) {
+
+    auto const name = meto::clock_type_name(type);
+    if (!meto::clock_type_available(type)) {
+      std::cout << std::left << std::setw(20) << name << "not available\n";
+      continue;
+    }
+
+    double const seconds_per_tick =
+        type == meto::ClockType::tsc ? meto::calibrate_tsc()
+        : type == meto::ClockType::steady
+            ? static_cast<double>(std::chrono::steady_clock::period::num) /
+                  static_cast<double>(std::chrono::steady_clock::period::den)
+            : 1.0e-9;
+
+    // Cost: mean time per read, over many back-to-back reads. The smallest
+    // non-zero difference between consecutive reads gives the resolution.
+    auto min_step = std::numeric_limits<meto::clock_ticks_t>::max();
+    meto::clock_ticks_t previous = meto::read_clock_ticks(type);
+
+    auto const start_time = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_reads; ++i) {
+      meto::clock_ticks_t const current = meto::read_clock_ticks(type);
+      if (current != previous) {
+        min_step = std::min(min_step, current - previous);
+      }
+      previous = current;
+    }
+    auto const end_time = std::chrono::steady_clock::now();
+
+    double const cost =
+        std::chrono::duration<double, std::nano>(end_time - start_time)
+            .count() /
+        num_reads;
+    double const resolution =
+        static_cast<double>(min_step) * seconds_per_tick * 1.0e9;
+
+    std::cout << std::left << std::setw(20) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(16) << cost << std::setw(20)
+              << resolution << "\n";
+  }
+
+  return 0;
+}
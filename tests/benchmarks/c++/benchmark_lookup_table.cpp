@@ -0,0 +1,114 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+//
+//  Compares the cost of looking up region records in the flat lookup table
+//  with that of the std::unordered_map it replaced, for a range of region
+//  counts per thread.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flat_lookup_table.h"
+#include "hashtable.h"
+
+namespace {
+
+// The hash function formerly used by the lookup table: region names are
+// already hashed, so the keys are used as they are.
+struct NullHashFunction {
+  std::size_t operator()(std::size_t const &key) const { return key; }
+};
+
+/**
+ * @brief  Times repeated lookups of every key, in a shuffled order.
+ * @param [in] keys    The keys to look up.
+ * @param [in] lookup  Looks up a key, returning its record index.
+ * @returns  Mean time per lookup, in nanoseconds.
+ */
+
+template <typename Lookup>
+double time_lookups(std::vector<std::size_t> const &keys, Lookup lookup) {
+
+  constexpr std::size_t num_lookups = 10000000;
+  auto const num_sweeps = std::max(std::size_t{1}, num_lookups / keys.size());
+
+  meto::record_index_t checksum = 0;
+  auto const start_time = std::chrono::steady_clock::now();
+  for (std::size_t sweep = 0; sweep < num_sweeps; ++sweep) {
+    for (auto const key : keys) {
+      checksum += lookup(key);
+    }
+  }
+  auto const end_time = std::chrono::steady_clock::now();
+
+  // Use the result, so that the lookups cannot be optimised away.
+  if (checksum == 1) {
+    std::cout << "";
+  }
+
+  return std::chrono::duration<double, std::nano>(end_time - start_time)
+             .count() /
+         static_cast<double>(num_sweeps * keys.size());
+}
+
+} // namespace
+
+int main() {
+
+  std::cout << std::left << std::setw(12) << "Regions" << std::right
+            << std::setw(24) << "unordered_map (ns)" << std::setw(24)
+            << "FlatLookupTable (ns)" << "\n";
+
+  std::mt19937_64 generator(42);
+  std::hash<std::string> hash_function;
+
+  for (std::size_t const num_regions :
+       {std::size_t{10}, std::size_t{1000}, std::size_t{50000}}) {
+
+    // Hash region names, as the profiler does.
+    std::vector<std::size_t> keys;
+    for (std::size_t i = 0; i < num_regions; ++i) {
+      keys.push_back(hash_function("region_" + std::to_string(i)));
+    }
+
+    std::unordered_map<std::size_t, meto::record_index_t, NullHashFunction>
+        map;
+    meto::FlatLookupTable table;
+    map.reserve(PROF_HASHVEC_RESERVE_SIZE);
+    table.reserve(PROF_HASHVEC_RESERVE_SIZE);
+    for (std::size_t i = 0; i < num_regions; ++i) {
+      map.emplace(keys[i], i);
+      table.insert_or_assign(keys[i], i);
+    }
+
+    // Visit the regions in an order unrelated to insertion.
+    std::shuffle(keys.begin(), keys.end(), generator);
+
+    double const map_cost = time_lookups(
+        keys, [&map](std::size_t const key) { return map.at(key); });
+    double const table_cost =
+        time_lookups(keys, [&table](std::size_t const key) {
+          meto::record_index_t index = 0;
+          table.find(key, index);
+          return index;
+        });
+
+    std::cout << std::left << std::setw(12) << num_regions << std::right
+              << std::fixed << std::setprecision(2) << std::setw(24)
+              << map_cost << std::setw(24) << table_cost << "\n";
+  }
+
+  return 0;
+}
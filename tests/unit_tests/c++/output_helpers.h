@@ -0,0 +1,62 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+/**
+ *  @file   output_helpers.h
+ *  @brief  Helpers for unit tests that read back the profile written.
+ */
+
+#ifndef VERNIER_OUTPUT_HELPERS_H
+#define VERNIER_OUTPUT_HELPERS_H
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief   Reads the whole of a Vernier output file, then removes it.
+ * @param [in]  filename  The output file name, including the rank suffix.
+ */
+
+inline std::string read_output(std::string const &filename) {
+  std::stringstream contents;
+  {
+    std::ifstream file(filename);
+    contents << file.rdbuf();
+  }
+  std::remove(filename.c_str());
+  return contents.str();
+}
+
+/**
+ * @brief   Finds the lines of output for a region.
+ * @param [in]  output  The whole output, as returned by read_output.
+ * @param [in]  region  The decorated region name, such as "Orzo@0".
+ * @returns     The whitespace-separated fields of each line whose first or
+ *              last field is the region name, in order.
+ */
+
+inline std::vector<std::vector<std::string>>
+find_region_lines(std::string const &output, std::string const &region) {
+  std::vector<std::vector<std::string>> region_lines;
+  std::istringstream lines(output);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream words(line);
+    std::vector<std::string> fields{std::istream_iterator<std::string>(words),
+                                    std::istream_iterator<std::string>()};
+    if (!fields.empty() &&
+        (fields.front() == region || fields.back() == region)) {
+      region_lines.push_back(fields);
+    }
+  }
+  return region_lines;
+}
+
+#endif
@@ -0,0 +1,201 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <initializer_list>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "vernier.h"
+
+using ::testing::ExitedWithCode;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+//
+//  Tests for profiling regions by call path.
+//
+
+namespace {
+
+// Hash of the call-tree node for a path of region names.
+size_t path_hash(std::initializer_list<std::string_view> const names) {
+  size_t hash = 0;
+  bool top = true;
+  for (auto const name : names) {
+    auto const region_hash = meto::hash_region_name(name);
+    hash = top ? region_hash : meto::hash_call_path(hash, region_hash);
+    top = false;
+  }
+  return hash;
+}
+
+// Calls a shared kernel, which sleeps for the given time.
+void kernel(int const sleep_ms) {
+  auto const hash = meto::vernier.start("kernel");
+  std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+  meto::vernier.stop(hash);
+}
+
+} // namespace
+
+// A region called from two parents is timed separately under each.
+TEST(CallTreeTest, SharedKernelTest) {
+  setenv("VERNIER_CALL_TREE", "1", 1);
+  meto::vernier.init();
+
+  auto const hash_main = meto::vernier.start("main");
+  for (int step = 0; step < 2; ++step) {
+    auto const hash_dynamics = meto::vernier.start("dynamics");
+    kernel(1);
+    meto::vernier.stop(hash_dynamics);
+
+    auto const hash_physics = meto::vernier.start("physics");
+    kernel(20);
+    kernel(20);
+    meto::vernier.stop(hash_physics);
+  }
+  meto::vernier.stop(hash_main);
+
+  auto const hash_dynamics_kernel = path_hash({"main", "dynamics", "kernel"});
+  auto const hash_physics_kernel = path_hash({"main", "physics", "kernel"});
+  EXPECT_EQ(meto::vernier.get_call_count(hash_dynamics_kernel, 0), 2);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_physics_kernel, 0), 4);
+  EXPECT_EQ(meto::vernier.get_call_count(path_hash({"main"}), 0), 1);
+  EXPECT_EQ(meto::vernier.get_call_count(meto::hash_region_name("kernel"), 0),
+            0);
+  EXPECT_GT(meto::vernier.get_total_walltime(hash_physics_kernel, 0),
+            meto::vernier.get_total_walltime(hash_dynamics_kernel, 0));
+
+  // Child times are charged to the parent node.
+  auto const hash_dynamics = path_hash({"main", "dynamics"});
+  EXPECT_EQ(meto::vernier.get_child_walltime(hash_dynamics, 0),
+            meto::vernier.get_total_walltime(hash_dynamics_kernel, 0));
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_CALL_TREE");
+}
+
+// Recursive calls are separate nodes.
+TEST(CallTreeTest, RecursionTest) {
+  setenv("VERNIER_CALL_TREE", "1", 1);
+  meto::vernier.init();
+
+  auto const hash_outer = meto::vernier.start("Conchiglie");
+  auto const hash_inner = meto::vernier.start("Conchiglie");
+  meto::vernier.stop(hash_inner);
+  meto::vernier.stop(hash_outer);
+
+  EXPECT_EQ(meto::vernier.get_call_count(path_hash({"Conchiglie"}), 0), 1);
+  EXPECT_EQ(meto::vernier.get_call_count(
+                path_hash({"Conchiglie", "Conchiglie"}), 0),
+            1);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_CALL_TREE");
+}
+
+// Regions deeper than the depth limit are profiled by name alone.
+TEST(CallTreeTest, DepthLimitTest) {
+  setenv("VERNIER_CALL_TREE", "1", 1);
+  setenv("VERNIER_CALL_TREE_DEPTH", "2", 1);
+  meto::vernier.init();
+
+  for (auto const parent : {"Ditalini", "Radiatori"}) {
+    auto const hash_top = meto::vernier.start(parent);
+    auto const hash_middle = meto::vernier.start("Rotini");
+    auto const hash_bottom = meto::vernier.start("Orecchiette");
+    meto::vernier.stop(hash_bottom);
+    meto::vernier.stop(hash_middle);
+    meto::vernier.stop(hash_top);
+  }
+
+  EXPECT_EQ(meto::vernier.get_call_count(path_hash({"Ditalini", "Rotini"}), 0),
+            1);
+  EXPECT_EQ(meto::vernier.get_call_count(path_hash({"Radiatori", "Rotini"}),
+                                         0),
+            1);
+  EXPECT_EQ(meto::vernier.get_call_count(
+                meto::hash_region_name("Orecchiette"), 0),
+            2);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_CALL_TREE_DEPTH");
+  unsetenv("VERNIER_CALL_TREE");
+}
+
+// Region handles and scoped regions resolve to call-tree nodes too.
+TEST(CallTreeTest, HandlesTest) {
+  setenv("VERNIER_CALL_TREE", "1", 1);
+  meto::vernier.init();
+
+  auto const handle = meto::vernier.register_region("Cavatappi");
+  for (auto const parent : {"Campanelle", "Casarecce", "Campanelle"}) {
+    auto const hash = meto::vernier.start(parent);
+    {
+      meto::ScopedRegion const region(handle);
+    }
+    meto::vernier.stop(hash);
+  }
+
+  EXPECT_EQ(meto::vernier.get_call_count(
+                path_hash({"Campanelle", "Cavatappi"}), 0),
+            2);
+  EXPECT_EQ(meto::vernier.get_call_count(
+                path_hash({"Casarecce", "Cavatappi"}), 0),
+            1);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_CALL_TREE");
+}
+
+// Nodes are written by call path, and regions met only below the top of the
+// tree are not written by name.
+TEST(CallTreeTest, OutputTest) {
+  setenv("VERNIER_CALL_TREE", "1", 1);
+  setenv("VERNIER_OUTPUT_FILENAME", "vernier-call-tree", 1);
+  meto::vernier.init();
+
+  auto const hash_main = meto::vernier.start("main");
+  auto const hash_dynamics = meto::vernier.start("dynamics");
+  kernel(0);
+  meto::vernier.stop(hash_dynamics);
+  meto::vernier.stop(hash_main);
+
+  meto::vernier.write();
+  meto::vernier.finalize();
+  unsetenv("VERNIER_OUTPUT_FILENAME");
+  unsetenv("VERNIER_CALL_TREE");
+
+  std::ifstream file("vernier-call-tree-0");
+  std::stringstream contents;
+  contents << file.rdbuf();
+  file.close();
+  std::remove("vernier-call-tree-0");
+
+  std::string const output = contents.str();
+  EXPECT_THAT(output, HasSubstr("Call tree: on."));
+  EXPECT_THAT(output, HasSubstr("\nmain@0 "));
+  EXPECT_THAT(output, HasSubstr("\nmain/dynamics@0 "));
+  EXPECT_THAT(output, HasSubstr("\nmain/dynamics/kernel@0 "));
+  EXPECT_THAT(output, Not(HasSubstr("\nkernel@0 ")));
+  EXPECT_THAT(output, Not(HasSubstr("\ndynamics@0 ")));
+}
+
+// The depth limit must be a positive integer.
+TEST(CallTreeDeathTest, InvalidDepthTest) {
+  setenv("VERNIER_CALL_TREE_DEPTH", "0", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid VERNIER_CALL_TREE_DEPTH.");
+  unsetenv("VERNIER_CALL_TREE_DEPTH");
+}
@@ -0,0 +1,72 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+
+#include "vernier.h"
+
+using ::testing::ExitedWithCode;
+
+//
+//  Tests for the lean calliper mode, in which overheads are estimated rather
+//  than measured.
+//
+
+// Lean callipers count calls and time regions as usual.
+TEST(CalliperModeTest, LeanCountTest) {
+  setenv("VERNIER_CALLIPER_MODE", "lean", 1);
+  meto::vernier.init();
+
+  size_t hash = 0;
+  for (int i = 0; i < 5; ++i) {
+    hash = meto::vernier.start("Farfalle");
+    meto::vernier.stop(hash);
+  }
+
+  EXPECT_EQ(meto::vernier.get_call_count(hash, 0), 5);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 5);
+  EXPECT_GE(meto::vernier.get_total_walltime(hash, 0), 0.0);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_CALLIPER_MODE");
+}
+
+// Each child call adds the same estimated overhead to its parent.
+TEST(CalliperModeTest, LeanOverheadTest) {
+  setenv("VERNIER_CALLIPER_MODE", "lean", 1);
+  meto::vernier.init();
+
+  auto const hash_a = meto::vernier.start("Fusilli");
+  auto hash_child = meto::vernier.start("Orzo");
+  meto::vernier.stop(hash_child);
+  meto::vernier.stop(hash_a);
+
+  auto const hash_b = meto::vernier.start("Gemelli");
+  for (int i = 0; i < 10; ++i) {
+    hash_child = meto::vernier.start("Orzo");
+    meto::vernier.stop(hash_child);
+  }
+  meto::vernier.stop(hash_b);
+
+  auto const overhead_a = meto::vernier.get_overhead_walltime(hash_a, 0);
+  auto const overhead_b = meto::vernier.get_overhead_walltime(hash_b, 0);
+  EXPECT_GT(overhead_a, 0.0);
+  EXPECT_DOUBLE_EQ(overhead_b, 10.0 * overhead_a);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_CALLIPER_MODE");
+}
+
+// An unrecognised calliper mode is an error.
+TEST(CalliperModeDeathTest, InvalidModeTest) {
+  setenv("VERNIER_CALLIPER_MODE", "svelte", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid Vernier calliper mode.");
+  unsetenv("VERNIER_CALLIPER_MODE");
+}
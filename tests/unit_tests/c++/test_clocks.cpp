@@ -0,0 +1,61 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "vernier.h"
+
+using ::testing::ExitedWithCode;
+
+//
+//  Tests for the clock backends.
+//
+
+// Every clock backend name can be parsed back to the same backend.
+TEST(ClockTest, NameTest) {
+  for (auto const type :
+       {meto::ClockType::steady, meto::ClockType::monotonic_raw,
+        meto::ClockType::monotonic_coarse, meto::ClockType::tsc}) {
+    EXPECT_EQ(meto::parse_clock_type(meto::clock_type_name(type)), type);
+  }
+}
+
+// Each available backend measures a sleep to within its resolution.
+TEST(ClockTest, SleepTest) {
+  for (auto const type :
+       {meto::ClockType::steady, meto::ClockType::monotonic_raw,
+        meto::ClockType::tsc}) {
+    if (!meto::clock_type_available(type)) {
+      continue;
+    }
+
+    setenv("VERNIER_CLOCK", meto::clock_type_name(type).c_str(), 1);
+    meto::vernier.init();
+    unsetenv("VERNIER_CLOCK");
+
+    EXPECT_EQ(meto::clock_settings.type_, type);
+
+    auto const start_time = meto::vernier_gettime();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto const elapsed = meto::vernier_gettime() - start_time;
+
+    EXPECT_GE(meto::ticks_to_seconds(elapsed), 0.05);
+    EXPECT_LT(meto::ticks_to_seconds(elapsed), 1.0);
+
+    meto::vernier.finalize();
+  }
+}
+
+// An unrecognised clock name is an error.
+TEST(ClockDeathTest, InvalidClockTest) {
+  setenv("VERNIER_CLOCK", "sundial", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid Vernier clock choice.");
+  unsetenv("VERNIER_CLOCK");
+}
@@ -0,0 +1,88 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "output_helpers.h"
+#include "vernier.h"
+
+using ::testing::ExitedWithCode;
+using ::testing::HasSubstr;
+
+//
+//  Tests for overhead-compensated output.
+//
+
+// Compensation removes the cost of nested callipers from a densely
+// instrumented region, and the output header reports the calibrated cost.
+TEST(CompensationTest, NestedOverheadTest) {
+  setenv("VERNIER_COMPENSATE", "1", 1);
+  setenv("VERNIER_OUTPUT_FILENAME", "vernier-compensation", 1);
+  meto::vernier.init();
+
+  auto const hash_parent = meto::vernier.start("Cannelloni");
+  for (int i = 0; i < 100000; ++i) {
+    auto const hash_child = meto::vernier.start("Ditalini");
+    meto::vernier.stop(hash_child);
+  }
+  meto::vernier.stop(hash_parent);
+
+  double const raw_total = meto::vernier.get_total_walltime(hash_parent, 0);
+  meto::vernier.write();
+  meto::vernier.finalize();
+  unsetenv("VERNIER_COMPENSATE");
+  unsetenv("VERNIER_OUTPUT_FILENAME");
+
+  auto const output = read_output("vernier-compensation-0");
+
+  EXPECT_THAT(output, HasSubstr("Overhead compensation: on."));
+
+  // Nearly all of the parent's time is spent in the child callipers.
+  auto const parent_lines = find_region_lines(output, "Cannelloni@0");
+  ASSERT_FALSE(parent_lines.empty());
+  double const compensated_total = std::stod(parent_lines.front()[2]);
+  EXPECT_GE(compensated_total, 0.0);
+  EXPECT_LT(compensated_total, 0.5 * raw_total);
+}
+
+// The calliper costs are calibrated once by init, so a thread's first calliper
+// is not slowed by calibration, which would be charged to any region open on
+// a thread waiting for it.
+TEST(CompensationTest, CalibratedAtInitTest) {
+  setenv("VERNIER_COMPENSATE", "1", 1);
+  meto::vernier.init();
+
+  double first_calliper_time = 0.0;
+  std::thread thread([&first_calliper_time]() {
+    auto const start_time = std::chrono::steady_clock::now();
+    auto const hash = meto::vernier.start("Ravioli");
+    meto::vernier.stop(hash);
+    first_calliper_time = std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - start_time)
+                              .count();
+  });
+  thread.join();
+
+  // Calibration times thousands of calliper pairs.
+  EXPECT_LT(first_calliper_time, 1.0e-4);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_COMPENSATE");
+}
+
+// An unrecognised compensation setting is an error.
+TEST(CompensationDeathTest, InvalidSettingTest) {
+  setenv("VERNIER_COMPENSATE", "yes", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid VERNIER_COMPENSATE.");
+  unsetenv("VERNIER_COMPENSATE");
+}
@@ -0,0 +1,77 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "output_helpers.h"
+#include "vernier.h"
+
+using ::testing::HasSubstr;
+
+//
+//  Tests for counting events without timing them.
+//
+
+// Counts accumulate by name and by handle, inside or outside any region,
+// without affecting the regions around them.
+TEST(CountTest, AccumulateTest) {
+  meto::vernier.init();
+
+  auto const handle = meto::vernier.register_region("Gnocchi");
+  auto const hash_counted = meto::hash_region_name("Gnocchi");
+
+  meto::vernier.count("Gnocchi");
+  auto const hash_parent = meto::vernier.start("Trofie");
+  for (int i = 0; i < 10; ++i) {
+    meto::vernier.count(handle);
+  }
+  meto::vernier.count("Gnocchi", 5);
+  meto::vernier.stop(hash_parent);
+
+  EXPECT_EQ(meto::vernier.get_event_count(hash_counted, 0), 16);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_counted, 0), 0);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_parent, 0), 1);
+  EXPECT_EQ(meto::vernier.get_child_walltime(hash_parent, 0), 0.0);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 1);
+
+  meto::vernier.finalize();
+}
+
+// Event counts are written in their own table, so they are never mixed into
+// the calls of a timed region, and regions that were only counted have no row
+// in the timings table.
+TEST(CountTest, OutputTest) {
+  setenv("VERNIER_OUTPUT_FILENAME", "vernier-count", 1);
+  meto::vernier.init();
+
+  auto const hash = meto::vernier.start("Trofie");
+  meto::vernier.count("Trofie", 3);
+  meto::vernier.count("Gnocchi", 42);
+  meto::vernier.stop(hash);
+
+  meto::vernier.write();
+  meto::vernier.finalize();
+  unsetenv("VERNIER_OUTPUT_FILENAME");
+
+  auto const output = read_output("vernier-count-0");
+  auto const timed_lines = find_region_lines(output, "Trofie@0");
+  auto const counted_lines = find_region_lines(output, "Gnocchi@0");
+
+  // Timings row with the calls only, then the event table row.
+  ASSERT_EQ(timed_lines.size(), 2);
+  ASSERT_EQ(timed_lines[0].size(), 5);
+  EXPECT_EQ(timed_lines[0][4], "1");
+  EXPECT_EQ(timed_lines[1], (std::vector<std::string>{"Trofie@0", "3"}));
+
+  ASSERT_EQ(counted_lines.size(), 1);
+  EXPECT_EQ(counted_lines[0], (std::vector<std::string>{"Gnocchi@0", "42"}));
+  EXPECT_NE(output.find("Counted region"), std::string::npos);
+}
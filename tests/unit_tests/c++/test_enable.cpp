@@ -0,0 +1,108 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include "vernier.h"
+
+using ::testing::ExitedWithCode;
+
+//
+//  Tests for disabling profiling at run time.
+//
+
+// When disabled, the callipers do nothing, even when they would otherwise be
+// in error, and no profile is written.
+TEST(EnableTest, DisabledTest) {
+  setenv("VERNIER_ENABLE", "0", 1);
+  setenv("VERNIER_OUTPUT_FILENAME", "vernier-disabled", 1);
+  std::remove("vernier-disabled-0");
+  meto::vernier.init();
+
+  auto const handle = meto::vernier.register_region("Conchiglie");
+  auto const hash = meto::vernier.start("Fusilli");
+  meto::vernier.start(handle);
+  meto::vernier.count("Farfalle", 3);
+  meto::vernier.count(handle);
+  {
+    VERNIER_SCOPED_REGION("Orecchiette");
+  }
+  meto::vernier.stop(hash);
+  meto::vernier.stop(handle);
+
+  EXPECT_EQ(hash, 0);
+
+  // Nothing is registered, and the getters return empty results rather than
+  // stopping the program.
+  EXPECT_EQ(handle.id_, meto::RegionHandle::unregistered_);
+  EXPECT_EQ(VERNIER_REGION("Rigatoni").id_, meto::RegionHandle::unregistered_);
+  EXPECT_EQ(meto::vernier.get_total_walltime(hash, 0), 0.0);
+  EXPECT_EQ(meto::vernier.get_self_walltime(hash, 0), 0.0);
+  EXPECT_EQ(meto::vernier.get_call_count(hash, 0), 0);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 0);
+  EXPECT_EQ(meto::vernier.get_decorated_region_name(hash, 0), "");
+
+  meto::vernier.write();
+  meto::vernier.finalize();
+  unsetenv("VERNIER_OUTPUT_FILENAME");
+  unsetenv("VERNIER_ENABLE");
+
+  std::ifstream output("vernier-disabled-0");
+  EXPECT_FALSE(output.good());
+}
+
+// VERNIER_ENABLE is honoured even by callipers called before init, which
+// would otherwise stop the program.
+TEST(EnableTest, CallBeforeInitTest) {
+  setenv("VERNIER_ENABLE", "0", 1);
+
+  auto const handle = meto::vernier.register_region("Conchiglie");
+  auto const hash = meto::vernier.start("Fusilli");
+  meto::vernier.start(handle);
+  meto::vernier.count(handle);
+  meto::vernier.stop(handle);
+  meto::vernier.stop(hash);
+  meto::vernier.mark_steady_state();
+  meto::vernier.write();
+
+  EXPECT_EQ(hash, 0);
+  EXPECT_EQ(handle.id_, meto::RegionHandle::unregistered_);
+  EXPECT_FALSE(meto::vernier.is_enabled());
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_ENABLE");
+}
+
+// Profiling is enabled again by the next init.
+TEST(EnableTest, ReenabledTest) {
+  setenv("VERNIER_ENABLE", "0", 1);
+  meto::vernier.init();
+  meto::vernier.finalize();
+
+  setenv("VERNIER_ENABLE", "1", 1);
+  meto::vernier.init();
+
+  auto const hash = meto::vernier.start("Fusilli");
+  meto::vernier.stop(hash);
+  EXPECT_EQ(hash, meto::hash_region_name("Fusilli"));
+  EXPECT_EQ(meto::vernier.get_call_count(hash, 0), 1);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_ENABLE");
+}
+
+// Values other than 0 and 1 are rejected.
+TEST(EnableTest, InvalidValueTest) {
+  setenv("VERNIER_ENABLE", "yes", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid VERNIER_ENABLE.");
+  unsetenv("VERNIER_ENABLE");
+}
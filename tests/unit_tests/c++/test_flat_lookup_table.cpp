@@ -0,0 +1,76 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "flat_lookup_table.h"
+
+//
+//  Tests for the open-addressing lookup table.
+//
+
+// Inserted entries can be found, updated and listed.
+TEST(FlatLookupTableTest, InsertFindTest) {
+
+  meto::FlatLookupTable table;
+  table.reserve(4);
+
+  table.insert_or_assign(11, 0);
+  table.insert_or_assign(22, 1);
+  table.insert_or_assign(11, 2);
+
+  meto::record_index_t index = 0;
+  EXPECT_TRUE(table.find(11, index));
+  EXPECT_EQ(index, 2);
+  EXPECT_TRUE(table.find(22, index));
+  EXPECT_EQ(index, 1);
+  EXPECT_FALSE(table.find(33, index));
+  EXPECT_THROW(table.at(33), std::out_of_range);
+  EXPECT_EQ(table.size(), 2);
+
+  std::size_t count = 0;
+  for (auto const &[hash, record_index] : table) {
+    EXPECT_EQ(table.at(hash), record_index);
+    ++count;
+  }
+  EXPECT_EQ(count, 2);
+}
+
+// Erasing from the middle of a run of colliding keys leaves the rest of the
+// run reachable.
+TEST(FlatLookupTableTest, EraseCollisionTest) {
+
+  meto::FlatLookupTable table;
+  table.reserve(8);
+
+  // Keys sharing their low bits collide on the same home slot.
+  for (std::size_t i = 0; i < 5; ++i) {
+    table.insert_or_assign(i << 20, i);
+  }
+  table.erase(std::size_t{1} << 20);
+
+  EXPECT_FALSE(table.contains(std::size_t{1} << 20));
+  for (std::size_t i : {0u, 2u, 3u, 4u}) {
+    EXPECT_EQ(table.at(i << 20), i);
+  }
+  EXPECT_EQ(table.size(), 4);
+}
+
+// The table grows beyond its reserved size without losing entries.
+TEST(FlatLookupTableTest, GrowthTest) {
+
+  meto::FlatLookupTable table;
+  table.reserve(2);
+
+  for (std::size_t i = 0; i < 10000; ++i) {
+    table.insert_or_assign(i * 2654435761u, i);
+  }
+  for (std::size_t i = 0; i < 10000; ++i) {
+    EXPECT_EQ(table.at(i * 2654435761u), i);
+  }
+}
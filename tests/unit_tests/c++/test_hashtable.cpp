@@ -10,16 +10,15 @@
 #include <omp.h>
 #endif
 
+#include <cstring>
+#include <string_view>
+#include <vector>
+
 #include "vernier.h"
 
 using ::testing::AllOf;
 using ::testing::An;
 using ::testing::Gt;
-using ::testing::HasSubstr;
-
-int const tid = 0;
-std::string tid_str(std::to_string(tid));
-std::string tid_bytes(reinterpret_cast<char const *>(&tid), sizeof(tid));
 
 //
 //  Testing that the hashing function works as expected (we don't want
@@ -46,12 +45,11 @@ TEST(HashTableTest, HashFunctionTest) {
     // Checking that:
     //  - query_insert'ing Penne or Rigatoni just returns the hash
     //  - the regions have different hashes
-    //  - the regions have the hashes returned by hash_function_ which uses
-    //  std::hash
+    //  - the regions have the hashes returned by hash_region_name
     EXPECT_EQ(meto::vernier.start("Rigatoni"),
-              std::hash<std::string_view>{}("Rigatoni" + tid_bytes));
-    EXPECT_EQ(meto::vernier.start("Penne"),
-              std::hash<std::string_view>{}("Penne" + tid_bytes));
+              meto::hash_region_name("Rigatoni"));
+    EXPECT_EQ(meto::vernier.start("Penne"), meto::hash_region_name("Penne"));
+    EXPECT_NE(prof_rigatoni, prof_penne);
   }
 
   meto::vernier.finalize();
@@ -68,7 +66,7 @@ TEST(HashTableTest, UpdateTimesTest) {
   meto::vernier.init();
 
   // Create new hash
-  size_t prof_pie = std::hash<std::string>{}("Pie" + tid_bytes);
+  size_t prof_pie = meto::hash_region_name("Pie");
 
   // Trying to find a time before .start() will throw an exception
   EXPECT_THROW(meto::vernier.get_total_walltime(prof_pie, 0),
@@ -116,19 +114,86 @@ TEST(HashTableTest, UpdateTimesTest) {
 }
 
 /*
- * Check handling of long labels.  Short labels have already been
- * tested, so try something longer than the maximum size, catch the
- * exit code and check the error message
+ * Check handling of long labels. There is no maximum length, and labels that
+ * differ only in their last character are distinct regions.
  */
 TEST(HashTableTest, NameLengthTest) {
 
-  // Create a label that is too long
-  std::string label(PROF_STRING_BUFFER_LENGTH + 10, 'q');
+  std::string const label(1000, 'q');
+  std::string const other_label = label.substr(1) + "r";
+
+  meto::vernier.init();
+
+  auto const prof_label = meto::vernier.start(label);
+  meto::vernier.stop(prof_label);
+  auto const prof_other_label = meto::vernier.start(other_label);
+  meto::vernier.stop(prof_other_label);
+
+  EXPECT_NE(prof_label, prof_other_label);
+  EXPECT_EQ(meto::vernier.get_decorated_region_name(prof_label, 0),
+            label + "@0");
+  EXPECT_EQ(meto::vernier.get_call_count(prof_other_label, 0), 1);
+
+  meto::vernier.finalize();
+}
+
+/*
+ * Region hashes depend only on the region name, so a region has the same hash
+ * on every thread.
+ */
+TEST(HashTableTest, ThreadIndependentHashTest) {
+
+  meto::vernier.init();
+
+  int max_threads = 1;
+#ifdef _OPENMP
+  max_threads = omp_get_max_threads();
+#endif
+
+  std::vector<size_t> hashes(static_cast<size_t>(max_threads));
+#pragma omp parallel
+  {
+    int thread_id = 0;
+#ifdef _OPENMP
+    thread_id = omp_get_thread_num();
+#endif
+    auto const hash = meto::vernier.start("Tortellini");
+    meto::vernier.stop(hash);
+    hashes[static_cast<size_t>(thread_id)] = hash;
+  }
+
+  for (auto const hash : hashes) {
+    EXPECT_EQ(hash, meto::hash_region_name("Tortellini"));
+  }
+
+  meto::vernier.finalize();
+}
+
+/*
+ * Region names are cached by address. A buffer reused for a different name of
+ * the same length must not be mistaken for the cached region.
+ */
+TEST(HashTableTest, NameCacheTest) {
 
   meto::vernier.init();
 
-  EXPECT_EXIT(meto::vernier.start(label), testing::ExitedWithCode(1),
-              HasSubstr("Vernier internal error: region name too long"));
+  char buffer[] = "Macaroni";
+  std::string_view const name(buffer);
+
+  for (int i = 0; i < 3; ++i) {
+    auto const prof_macaroni = meto::vernier.start(name);
+    meto::vernier.stop(prof_macaroni);
+    EXPECT_EQ(prof_macaroni, meto::hash_region_name("Macaroni"));
+  }
+
+  std::memcpy(buffer, "Tortelli", sizeof(buffer));
+  auto const prof_tortelli = meto::vernier.start(name);
+  meto::vernier.stop(prof_tortelli);
+
+  EXPECT_EQ(prof_tortelli, meto::hash_region_name("Tortelli"));
+  EXPECT_EQ(meto::vernier.get_call_count(prof_tortelli, 0), 1);
+  EXPECT_EQ(
+      meto::vernier.get_call_count(meto::hash_region_name("Macaroni"), 0), 3);
 
   meto::vernier.finalize();
 }
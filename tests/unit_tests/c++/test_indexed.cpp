@@ -0,0 +1,140 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "vernier.h"
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+//
+//  Tests for regions indexed by a name and an integer key.
+//
+
+// Each key is a separate region, and the same key always gives the same hash.
+TEST(IndexedRegionTest, DistinctKeysTest) {
+  meto::vernier.init();
+
+  auto const name_hash = meto::hash_region_name("Fusilli");
+  for (int call = 0; call < 3; ++call) {
+    for (int level = 0; level < 4; ++level) {
+      auto const hash = meto::vernier.start_indexed("Fusilli", level);
+      EXPECT_EQ(hash, meto::hash_indexed_region(name_hash, level));
+      meto::vernier.stop(hash);
+    }
+  }
+
+  EXPECT_NE(meto::hash_indexed_region(name_hash, 0),
+            meto::hash_indexed_region(name_hash, 1));
+  EXPECT_NE(meto::hash_indexed_region(name_hash, 0), name_hash);
+  for (int level = 0; level < 4; ++level) {
+    EXPECT_EQ(meto::vernier.get_call_count(
+                  meto::hash_indexed_region(name_hash, level), 0),
+              3);
+  }
+
+  meto::vernier.finalize();
+}
+
+// Repeated starts look up the name by address, but a different name later
+// held at the same address is hashed afresh.
+TEST(IndexedRegionTest, CachedNameTest) {
+  meto::vernier.init();
+
+  char name[] = "Orzo";
+  for (int call = 0; call < 2; ++call) {
+    auto const hash = meto::vernier.start_indexed(name, 3);
+    EXPECT_EQ(hash,
+              meto::hash_indexed_region(meto::hash_region_name("Orzo"), 3));
+    meto::vernier.stop(hash);
+  }
+
+  std::strcpy(name, "Ziti");
+  auto const hash = meto::vernier.start_indexed(name, 3);
+  EXPECT_EQ(hash,
+            meto::hash_indexed_region(meto::hash_region_name("Ziti"), 3));
+  meto::vernier.stop(hash);
+
+  meto::vernier.finalize();
+}
+
+// Indexed regions nest inside, and around, named regions.
+TEST(IndexedRegionTest, NestingTest) {
+  meto::vernier.init();
+
+  auto const hash_outer = meto::vernier.start("Penne");
+  auto const hash_level = meto::vernier.start_indexed("Penne", 7);
+  auto const hash_inner = meto::vernier.start("Penne");
+  meto::vernier.stop(hash_inner);
+  meto::vernier.stop(hash_level);
+  meto::vernier.stop(hash_outer);
+
+  EXPECT_NE(hash_level, hash_outer);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_outer, 0), 2);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_level, 0), 1);
+
+  meto::vernier.finalize();
+}
+
+// Indexed regions are written as name[key], and filtered by their name.
+TEST(IndexedRegionTest, OutputTest) {
+  setenv("VERNIER_EXCLUDE", "ukca_*", 1);
+  setenv("VERNIER_OUTPUT_FILENAME", "vernier-indexed", 1);
+  meto::vernier.init();
+
+  for (int level = -1; level < 2; ++level) {
+    auto const hash = meto::vernier.start_indexed("Rigatoni", level);
+    meto::vernier.stop(hash);
+  }
+  auto const hash = meto::vernier.start_indexed("ukca_chemistry", 3);
+  meto::vernier.stop(hash);
+
+  meto::vernier.write();
+  meto::vernier.finalize();
+  unsetenv("VERNIER_OUTPUT_FILENAME");
+  unsetenv("VERNIER_EXCLUDE");
+
+  std::ifstream file("vernier-indexed-0");
+  std::stringstream contents;
+  contents << file.rdbuf();
+  file.close();
+  std::remove("vernier-indexed-0");
+
+  std::string const output = contents.str();
+  EXPECT_THAT(output, HasSubstr("Rigatoni[-1]@0"));
+  EXPECT_THAT(output, HasSubstr("Rigatoni[0]@0"));
+  EXPECT_THAT(output, HasSubstr("Rigatoni[1]@0"));
+  EXPECT_THAT(output, Not(HasSubstr("ukca_chemistry")));
+}
+
+// Keys met once the region limit is reached are folded into the overflow
+// record.
+TEST(IndexedRegionTest, RegionLimitTest) {
+  setenv("VERNIER_MAX_REGIONS", "2", 1);
+  meto::vernier.init();
+
+  auto const hash_overflow = meto::hash_region_name(PROF_OVERFLOW_REGION);
+  for (int level = 0; level < 5; ++level) {
+    auto const hash = meto::vernier.start_indexed("Farfalle", level);
+    EXPECT_EQ(hash, level < 2 ? meto::hash_indexed_region(
+                                    meto::hash_region_name("Farfalle"), level)
+                              : hash_overflow);
+    meto::vernier.stop(hash);
+  }
+  EXPECT_EQ(meto::vernier.get_call_count(hash_overflow, 0), 3);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_MAX_REGIONS");
+}
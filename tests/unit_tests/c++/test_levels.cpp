@@ -0,0 +1,77 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include "vernier.h"
+
+//
+//  Tests for callipers tagged with an instrumentation level. This test is
+//  built with a maximum level of 1, through its VERNIER_MAX_LEVEL property.
+//
+
+static_assert(VERNIER_MAX_LEVEL == 1);
+static_assert(meto::level_enabled<1>);
+static_assert(!meto::level_enabled<2>);
+static_assert(meto::level_enabled<2, 3>);
+
+// Callipers above the maximum level record nothing.
+TEST(LevelTest, NamedRegionTest) {
+  meto::vernier.init();
+
+  auto const hash_coarse = meto::vernier.start<1>("Tagliatelle");
+  auto const hash_fine = meto::vernier.start<2>("Pappardelle");
+  meto::vernier.stop<2>(hash_fine);
+  meto::vernier.stop<1>(hash_coarse);
+
+  EXPECT_EQ(hash_coarse, meto::hash_region_name("Tagliatelle"));
+  EXPECT_EQ(hash_fine, 0);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_coarse, 0), 1);
+  EXPECT_EQ(meto::vernier.get_child_walltime(hash_coarse, 0), 0.0);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 1);
+
+  meto::vernier.finalize();
+}
+
+// Levels apply equally to pre-registered regions.
+TEST(LevelTest, HandleTest) {
+  meto::vernier.init();
+
+  auto const handle_coarse = meto::vernier.register_region("Tagliatelle");
+  auto const handle_fine = meto::vernier.register_region("Pappardelle");
+
+  meto::vernier.start<1>(handle_coarse);
+  for (int i = 0; i < 10; ++i) {
+    meto::vernier.start<2>(handle_fine);
+    meto::vernier.stop<2>(handle_fine);
+  }
+  meto::vernier.stop<1>(handle_coarse);
+
+  EXPECT_EQ(meto::vernier.get_call_count(
+                meto::hash_region_name("Tagliatelle"), 0),
+            1);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 1);
+
+  meto::vernier.finalize();
+}
+
+// Scoped regions above the maximum level are neither timed nor registered.
+TEST(LevelTest, ScopedRegionTest) {
+  meto::vernier.init();
+
+  auto const hash = meto::hash_region_name("Tagliatelle");
+  {
+    VERNIER_SCOPED_REGION_LEVEL(1, "Tagliatelle");
+    VERNIER_SCOPED_REGION_LEVEL(2, "Pappardelle");
+  }
+
+  EXPECT_EQ(sizeof(meto::LevelScopedRegion<false>), 1);
+  EXPECT_EQ(meto::vernier.get_call_count(hash, 0), 1);
+  EXPECT_EQ(meto::vernier.get_child_walltime(hash, 0), 0.0);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 1);
+
+  meto::vernier.finalize();
+}
@@ -8,6 +8,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <vector>
 
 #include "error_handler.h"
 #include "hashvec_handler.h"
@@ -50,7 +51,7 @@ TEST(DeathTest, StopBeforeStartTest) {
 
   EXPECT_EXIT(
       {
-        const auto prof_main = std::hash<std::string_view>{}("Main");
+        const auto prof_main = meto::hash_region_name("Main");
 
         // Stop Vernier before anything is done
         meto::vernier.stop(prof_main);
@@ -89,8 +90,8 @@ TEST(DeathTest, VernierUninitialisedInWrite) {
   // clang-format on
 }
 
-// The traceback array is not a growable vector. Check that the code exits
-// when available array elements are exhausted.
+// The traceback grows up to a maximum depth. Check that the code exits
+// when the maximum depth is exceeded.
 TEST(DeathTest, TooManyTracebackEntries) {
 
   meto::vernier.init();
@@ -109,6 +110,46 @@ TEST(DeathTest, TooManyTracebackEntries) {
   meto::vernier.finalize();
 }
 
+// The maximum traceback depth can be set at runtime.
+TEST(DeathTest, MaxDepthTest) {
+
+  setenv("VERNIER_MAX_DEPTH", "5", 1);
+  meto::vernier.init();
+  unsetenv("VERNIER_MAX_DEPTH");
+
+  EXPECT_EXIT(
+      {
+        for (int i = 0; i < 6; ++i) {
+          [[maybe_unused]] auto prof_handle = meto::vernier.start("Shallow");
+        }
+      },
+      ExitedWithCode(EXIT_FAILURE),
+      "EMERGENCY STOP: Traceback array exhausted. The maximum depth is 5");
+
+  meto::vernier.finalize();
+}
+
+// Raising the maximum traceback depth permits deeper call stacks.
+TEST(ProfilerTest, DeepTracebackTest) {
+
+  setenv("VERNIER_MAX_DEPTH", "5000", 1);
+  meto::vernier.init();
+  unsetenv("VERNIER_MAX_DEPTH");
+
+  constexpr int depth = 2 * PROF_MAX_TRACEBACK_SIZE;
+  std::vector<size_t> hashes;
+  for (int i = 0; i < depth; ++i) {
+    hashes.push_back(meto::vernier.start("Deep"));
+  }
+  for (auto it = hashes.rbegin(); it != hashes.rend(); ++it) {
+    meto::vernier.stop(*it);
+  }
+
+  EXPECT_EQ(meto::vernier.get_call_count(hashes.front(), 0), depth);
+
+  meto::vernier.finalize();
+}
+
 // Tests the correct io mode is set. If not set correctly it will exit.
 TEST(DeathTest, InvalidIOModeTest) {
   EXPECT_EXIT(
@@ -0,0 +1,181 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "vernier.h"
+
+using ::testing::ExitedWithCode;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+//
+//  Tests for filtering regions by name.
+//
+
+// An excluded region is ignored, and its children are attributed to its
+// parent.
+TEST(RegionFilterTest, ExcludeTest) {
+  setenv("VERNIER_EXCLUDE", "ukca_*", 1);
+  meto::vernier.init();
+
+  size_t hash_parent = 0;
+  size_t hash_excluded = 0;
+  size_t hash_child = 0;
+  for (int i = 0; i < 3; ++i) {
+    hash_parent = meto::vernier.start("Bucatini");
+    hash_excluded = meto::vernier.start("ukca_chemistry");
+    hash_child = meto::vernier.start("Vermicelli");
+    meto::vernier.stop(hash_child);
+    meto::vernier.stop(hash_excluded);
+    meto::vernier.stop(hash_parent);
+  }
+
+  EXPECT_EQ(meto::vernier.get_call_count(hash_parent, 0), 3);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_excluded, 0), 0);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_child, 0), 3);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 6);
+  EXPECT_DOUBLE_EQ(meto::vernier.get_child_walltime(hash_parent, 0),
+                   meto::vernier.get_total_walltime(hash_child, 0));
+
+  // A filtered region may also be started and stopped outside any other.
+  hash_excluded = meto::vernier.start("ukca_aerosol");
+  meto::vernier.stop(hash_excluded);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_EXCLUDE");
+}
+
+// With include patterns, regions that match none of them are ignored.
+TEST(RegionFilterTest, IncludeTest) {
+  setenv("VERNIER_INCLUDE", "Buca*,Vermicelli", 1);
+  meto::vernier.init();
+
+  auto const hash_included = meto::vernier.start("Bucatini");
+  auto const hash_ignored = meto::vernier.start("Spaghetti");
+  meto::vernier.stop(hash_ignored);
+  meto::vernier.stop(hash_included);
+
+  EXPECT_EQ(meto::vernier.get_call_count(hash_included, 0), 1);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_ignored, 0), 0);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_INCLUDE");
+}
+
+// Patterns can be read from a file, and filtered regions are left out of the
+// output.
+TEST(RegionFilterTest, FilterFileTest) {
+  {
+    std::ofstream filter_file("vernier-filter.txt");
+    filter_file << "# Chemistry is switched off.\n"
+                << "\n"
+                << "include *\n"
+                << "exclude ukca_*\n";
+  }
+  setenv("VERNIER_FILTER_FILE", "vernier-filter.txt", 1);
+  setenv("VERNIER_OUTPUT_FILENAME", "vernier-filter", 1);
+  meto::vernier.init();
+
+  auto const hash_included = meto::vernier.start("Bucatini");
+  auto const hash_excluded = meto::vernier.start("ukca_chemistry");
+  meto::vernier.stop(hash_excluded);
+  meto::vernier.stop(hash_included);
+
+  meto::vernier.write();
+  meto::vernier.finalize();
+  unsetenv("VERNIER_FILTER_FILE");
+  unsetenv("VERNIER_OUTPUT_FILENAME");
+  std::remove("vernier-filter.txt");
+
+  std::ifstream file("vernier-filter-0");
+  std::stringstream contents;
+  contents << file.rdbuf();
+  file.close();
+  std::remove("vernier-filter-0");
+
+  std::string const output = contents.str();
+  EXPECT_THAT(output, HasSubstr("Filtering: on."));
+  EXPECT_THAT(output, HasSubstr("Bucatini@0"));
+  EXPECT_THAT(output, Not(HasSubstr("ukca_chemistry")));
+}
+
+// Manifests written by vernier-manifest give the number of regions, and
+// exclude region names with glob metacharacters escaped. Regions beyond the
+// number given are still profiled.
+TEST(RegionFilterTest, ManifestTest) {
+  {
+    std::ofstream filter_file("vernier-manifest.txt");
+    filter_file << "# Vernier manifest\n"
+                << "regions 3\n"
+                << "exclude ukca\\[1\\]\n";
+  }
+
+  meto::RegionFilter region_filter;
+  region_filter.read_file("vernier-manifest.txt");
+  EXPECT_EQ(region_filter.get_expected_regions(), 3);
+  EXPECT_TRUE(region_filter.is_filtered("ukca[1]"));
+  EXPECT_FALSE(region_filter.is_filtered("ukca1"));
+
+  setenv("VERNIER_FILTER_FILE", "vernier-manifest.txt", 1);
+  meto::vernier.init();
+
+  std::vector<std::string> const names = {"Bucatini", "Ziti", "Rigatoni",
+                                          "Penne", "ukca[1]"};
+  for (auto const &name : names) {
+    auto const hash = meto::vernier.start(name);
+    meto::vernier.stop(hash);
+  }
+  EXPECT_EQ(meto::vernier.get_call_count(meto::hash_region_name("Penne"), 0),
+            1);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 4);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_FILTER_FILE");
+  std::remove("vernier-manifest.txt");
+}
+
+// A filter file that cannot be read is an error.
+TEST(RegionFilterDeathTest, MissingFileTest) {
+  setenv("VERNIER_FILTER_FILE", "vernier-no-such-filter.txt", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "cannot open filter file");
+  unsetenv("VERNIER_FILTER_FILE");
+}
+
+// Each line of a filter file must start with include or exclude.
+TEST(RegionFilterDeathTest, InvalidLineTest) {
+  {
+    std::ofstream filter_file("vernier-bad-filter.txt");
+    filter_file << "omit ukca_*\n";
+  }
+  setenv("VERNIER_FILTER_FILE", "vernier-bad-filter.txt", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid line in filter file");
+  unsetenv("VERNIER_FILTER_FILE");
+  std::remove("vernier-bad-filter.txt");
+}
+
+// The number of regions must be a non-negative integer.
+TEST(RegionFilterDeathTest, InvalidRegionCountTest) {
+  {
+    std::ofstream filter_file("vernier-bad-manifest.txt");
+    filter_file << "regions many\n";
+  }
+  setenv("VERNIER_FILTER_FILE", "vernier-bad-manifest.txt", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid region count in filter file");
+  unsetenv("VERNIER_FILTER_FILE");
+  std::remove("vernier-bad-manifest.txt");
+}
@@ -0,0 +1,133 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "vernier.h"
+
+using ::testing::ExitedWithCode;
+
+//
+//  Tests for pre-registered region handles.
+//
+
+// Registering the same name twice gives the same handle, on any thread.
+TEST(RegionHandleTest, RegisterTwiceTest) {
+
+  auto const handle_a = meto::vernier.register_region("Tagliatelle");
+  auto const handle_b = meto::vernier.register_region("Fusilli");
+
+  EXPECT_EQ(meto::vernier.register_region("Tagliatelle").id_, handle_a.id_);
+  EXPECT_NE(handle_a.id_, handle_b.id_);
+
+#pragma omp parallel
+  {
+    EXPECT_EQ(meto::vernier.register_region("Fusilli").id_, handle_b.id_);
+  }
+}
+
+// Handle-based callipers update the same records as name-based callipers.
+TEST(RegionHandleTest, MatchesNamedRegionTest) {
+
+  meto::vernier.init();
+
+  auto const handle = meto::vernier.register_region("Farfalle");
+
+#pragma omp parallel
+  {
+    for (int i = 0; i < 3; ++i) {
+      meto::vernier.start(handle);
+      meto::vernier.stop(handle);
+    }
+
+    // Mixing name-based and handle-based callipers is permitted.
+    auto const hash = meto::vernier.start("Farfalle");
+    meto::vernier.stop(hash);
+  }
+
+  auto const hash = meto::vernier.start("Farfalle");
+  meto::vernier.stop(hash);
+
+  EXPECT_EQ(meto::vernier.get_call_count(hash, 0), 5);
+  EXPECT_EQ(meto::vernier.get_decorated_region_name(hash, 0), "Farfalle@0");
+
+  meto::vernier.finalize();
+}
+
+// Handles remain valid across init/finalize cycles.
+TEST(RegionHandleTest, ReinitialiseTest) {
+
+  auto const handle = meto::vernier.register_region("Orzo");
+
+  for (int cycle = 0; cycle < 2; ++cycle) {
+    meto::vernier.init();
+    meto::vernier.start(handle);
+    meto::vernier.stop(handle);
+    auto const hash = meto::vernier.start("Orzo");
+    meto::vernier.stop(hash);
+    EXPECT_EQ(meto::vernier.get_call_count(hash, 0), 2);
+    meto::vernier.finalize();
+  }
+}
+
+// Make sure the code exits when stopping a handle that is not the innermost
+// region.
+TEST(RegionHandleDeathTest, WrongHandleTest) {
+
+  meto::vernier.init();
+
+  auto const handle_outer = meto::vernier.register_region("Lasagne");
+  auto const handle_inner = meto::vernier.register_region("Cannelloni");
+
+  EXPECT_EXIT(
+      {
+        meto::vernier.start(handle_outer);
+        meto::vernier.start(handle_inner);
+        meto::vernier.stop(handle_outer);
+      },
+      ExitedWithCode(EXIT_FAILURE), "EMERGENCY STOP: hashes don't match.");
+
+  meto::vernier.finalize();
+}
+
+// Region names given as string literals are hashed at compile time.
+TEST(RegionHandleTest, CompileTimeHashTest) {
+
+  // Reference values, which must not change between platforms, since hashes
+  // are compared across MPI ranks.
+  static_assert(meto::hash_region_name("") == 0x93228a4de0eec5a2ULL);
+  static_assert(meto::hash_region_name("a") == 0xaced12527fe5bff8ULL);
+  static_assert(meto::hash_region_name("abcdefghijklmnopqrstuvwxyz0123456789"
+                                       "abcdefghijklmnopqrstuvwxyz") ==
+                0x197c9d7a4dd61442ULL);
+
+  // The seed changes the hash.
+  static_assert(meto::hash_region_name("a", 1) != meto::hash_region_name("a"));
+
+  EXPECT_EQ(meto::hash_region_name(std::string("Gnocchi")),
+            meto::hash_region_name("Gnocchi"));
+}
+
+// Each VERNIER_REGION call site caches the same handle as register_region.
+TEST(RegionHandleTest, RegionMacroTest) {
+
+  meto::vernier.init();
+
+  for (int i = 0; i < 2; ++i) {
+    meto::vernier.start(VERNIER_REGION("Ravioli"));
+    meto::vernier.stop(VERNIER_REGION("Ravioli"));
+  }
+
+  EXPECT_EQ(VERNIER_REGION("Ravioli").id_,
+            meto::vernier.register_region("Ravioli").id_);
+
+  auto const hash = meto::vernier.start("Ravioli");
+  meto::vernier.stop(hash);
+  EXPECT_EQ(meto::vernier.get_call_count(hash, 0), 3);
+
+  meto::vernier.finalize();
+}
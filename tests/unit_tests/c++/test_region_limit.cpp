@@ -0,0 +1,133 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "vernier.h"
+
+using ::testing::ExitedWithCode;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+//
+//  Tests for limiting the number of regions on each thread.
+//
+
+// Names met once the limit is reached are folded into the overflow record,
+// whose hash is returned to the caller.
+TEST(RegionLimitTest, OverflowTest) {
+  setenv("VERNIER_MAX_REGIONS", "3", 1);
+  meto::vernier.init();
+
+  auto const hash_overflow = meto::hash_region_name(PROF_OVERFLOW_REGION);
+  for (int call = 0; call < 2; ++call) {
+    for (int level = 0; level < 10; ++level) {
+      auto const name = "Lasagne_" + std::to_string(level);
+      auto const hash = meto::vernier.start(name);
+      EXPECT_EQ(hash, level < 3 ? meto::hash_region_name(name) : hash_overflow);
+      meto::vernier.stop(hash);
+    }
+  }
+
+  EXPECT_EQ(meto::vernier.get_call_count(
+                meto::hash_region_name("Lasagne_2"), 0),
+            2);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_overflow, 0), 14);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 20);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_MAX_REGIONS");
+}
+
+// Nested regions may both be folded into the overflow record.
+TEST(RegionLimitTest, NestedOverflowTest) {
+  setenv("VERNIER_MAX_REGIONS", "1", 1);
+  meto::vernier.init();
+
+  auto const hash_outer = meto::vernier.start("Cannelloni");
+  auto const hash_middle = meto::vernier.start("Manicotti");
+  auto const hash_inner = meto::vernier.start("Tortellini");
+  meto::vernier.stop(hash_inner);
+  meto::vernier.stop(hash_middle);
+  meto::vernier.stop(hash_outer);
+
+  EXPECT_EQ(hash_middle, hash_inner);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_inner, 0), 2);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_outer, 0), 1);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_MAX_REGIONS");
+}
+
+// Names that are filtered out stay filtered out once the limit is reached.
+TEST(RegionLimitTest, FilteredOverflowTest) {
+  setenv("VERNIER_MAX_REGIONS", "1", 1);
+  setenv("VERNIER_EXCLUDE", "ukca_*", 1);
+  meto::vernier.init();
+
+  auto const hash_outer = meto::vernier.start("Cannelloni");
+  auto const hash_excluded = meto::vernier.start("ukca_chemistry");
+  auto const hash_folded = meto::vernier.start("Tortellini");
+  meto::vernier.stop(hash_folded);
+  meto::vernier.stop(hash_excluded);
+  meto::vernier.stop(hash_outer);
+
+  EXPECT_EQ(meto::vernier.get_call_count(
+                meto::hash_region_name(PROF_OVERFLOW_REGION), 0),
+            1);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 2);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_EXCLUDE");
+  unsetenv("VERNIER_MAX_REGIONS");
+}
+
+// The output notes how many distinct names were folded.
+TEST(RegionLimitTest, OutputTest) {
+  setenv("VERNIER_MAX_REGIONS", "2", 1);
+  setenv("VERNIER_OUTPUT_FILENAME", "vernier-region-limit", 1);
+  meto::vernier.init();
+
+  for (int call = 0; call < 3; ++call) {
+    for (int field = 0; field < 7; ++field) {
+      auto const hash = meto::vernier.start("Ravioli_" + std::to_string(field));
+      meto::vernier.stop(hash);
+    }
+  }
+
+  meto::vernier.write();
+  meto::vernier.finalize();
+  unsetenv("VERNIER_OUTPUT_FILENAME");
+  unsetenv("VERNIER_MAX_REGIONS");
+
+  std::ifstream file("vernier-region-limit-0");
+  std::stringstream contents;
+  contents << file.rdbuf();
+  file.close();
+  std::remove("vernier-region-limit-0");
+
+  std::string const output = contents.str();
+  EXPECT_THAT(output, HasSubstr("Region limit: 2 regions per thread. About 5 "
+                                "region names were folded into __overflow__."));
+  EXPECT_THAT(output, HasSubstr("__overflow__@0"));
+  EXPECT_THAT(output, HasSubstr("Ravioli_1@0"));
+  EXPECT_THAT(output, Not(HasSubstr("Ravioli_2@0")));
+}
+
+// The limit must be a positive integer.
+TEST(RegionLimitDeathTest, InvalidValueTest) {
+  setenv("VERNIER_MAX_REGIONS", "0", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid VERNIER_MAX_REGIONS.");
+  unsetenv("VERNIER_MAX_REGIONS");
+}
@@ -19,7 +19,6 @@
 
 int const tid = 0;
 std::string tid_str(std::to_string(tid));
-std::string tid_bytes(reinterpret_cast<char const *>(&tid), sizeof(tid));
 
 TEST(RegionNameTest, NamesMatchTest) {
 
@@ -56,8 +55,7 @@ TEST(RegionNameTest, NamesMatchTest) {
     SCOPED_TRACE("Problem with the profiler region name");
 
     // Get profiler region name out from the profiler and test
-    auto const prof_self_handle =
-        std::hash<std::string_view>{}("__vernier__" + tid_bytes);
+    auto const prof_self_handle = meto::hash_region_name("__vernier__");
     std::string profilerRegionName =
         meto::vernier.get_decorated_region_name(prof_self_handle, tid);
     EXPECT_EQ("__vernier__@" + tid_str, profilerRegionName);
@@ -0,0 +1,157 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "output_helpers.h"
+#include "vernier.h"
+
+using ::testing::ExitedWithCode;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+//
+//  Tests for sampled timing, in which regions are timed on one in N calls.
+//
+
+// Every call is counted, whether or not it is timed, and regions nested in
+// calls that are not timed are still timed.
+TEST(SamplingTest, CountTest) {
+  setenv("VERNIER_SAMPLE_RATE", "10", 1);
+  meto::vernier.init();
+
+  size_t hash_parent = 0;
+  size_t hash_child = 0;
+  for (int i = 0; i < 95; ++i) {
+    hash_parent = meto::vernier.start("Penne");
+    hash_child = meto::vernier.start("Rotini");
+    meto::vernier.stop(hash_child);
+    meto::vernier.stop(hash_parent);
+  }
+
+  EXPECT_EQ(meto::vernier.get_call_count(hash_parent, 0), 95);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_child, 0), 95);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 190);
+  EXPECT_GT(meto::vernier.get_total_walltime(hash_child, 0), 0.0);
+  EXPECT_GT(meto::vernier.get_child_walltime(hash_parent, 0), 0.0);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_SAMPLE_RATE");
+}
+
+// Calls that are not timed are charged the time of a timed call, so the total
+// is an estimate of the time over all calls.
+TEST(SamplingTest, EstimateTest) {
+  setenv("VERNIER_SAMPLE_RATE", "4", 1);
+  meto::vernier.init();
+
+  size_t hash = 0;
+  for (int i = 0; i < 20; ++i) {
+    hash = meto::vernier.start("Radiatori");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    meto::vernier.stop(hash);
+  }
+
+  double const total = meto::vernier.get_total_walltime(hash, 0);
+  EXPECT_GE(total, 0.040);
+  EXPECT_LT(total, 0.200);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_SAMPLE_RATE");
+}
+
+// A slow first call is not charged to the calls that are not timed, so
+// sampled children do not take more time than their parent.
+TEST(SamplingTest, ColdFirstCallTest) {
+  setenv("VERNIER_SAMPLE_RATE", "10", 1);
+  meto::vernier.init();
+
+  auto const hash_parent = meto::vernier.start("Mafalde");
+  size_t hash_child = 0;
+  for (int i = 0; i < 50; ++i) {
+    hash_child = meto::vernier.start("Trofie");
+    if (i == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    meto::vernier.stop(hash_child);
+  }
+  meto::vernier.stop(hash_parent);
+
+  double const parent_total = meto::vernier.get_total_walltime(hash_parent, 0);
+  double const child_total = meto::vernier.get_total_walltime(hash_child, 0);
+  EXPECT_LT(child_total, parent_total);
+  EXPECT_LT(child_total, 0.030);
+  EXPECT_GE(meto::vernier.get_self_walltime(hash_parent, 0), 0.0);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_SAMPLE_RATE");
+}
+
+// Per-region rates override the default, and sampled regions, and their
+// parents, are marked in the output.
+TEST(SamplingTest, RegionRateTest) {
+  setenv("VERNIER_SAMPLE_REGIONS", "Tortiglioni=5", 1);
+  setenv("VERNIER_OUTPUT_FILENAME", "vernier-sampling", 1);
+  meto::vernier.init();
+
+  auto const hash_parent = meto::vernier.start("Ziti");
+  for (int i = 0; i < 10; ++i) {
+    auto const hash_sampled = meto::vernier.start("Tortiglioni");
+    meto::vernier.stop(hash_sampled);
+    auto const hash_timed = meto::vernier.start("Paccheri");
+    meto::vernier.stop(hash_timed);
+  }
+  meto::vernier.stop(hash_parent);
+
+  meto::vernier.write();
+  meto::vernier.finalize();
+  unsetenv("VERNIER_SAMPLE_REGIONS");
+  unsetenv("VERNIER_OUTPUT_FILENAME");
+
+  std::string const output = read_output("vernier-sampling-0");
+  EXPECT_THAT(output, HasSubstr("Sampling: on."));
+
+  std::string sampled_line;
+  std::string timed_line;
+  std::string parent_line;
+  std::istringstream lines(output);
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (line.rfind("Tortiglioni@0", 0) == 0) {
+      sampled_line = line;
+    } else if (line.rfind("Paccheri@0", 0) == 0) {
+      timed_line = line;
+    } else if (line.rfind("Ziti@0", 0) == 0) {
+      parent_line = line;
+    }
+  }
+  EXPECT_THAT(sampled_line, HasSubstr(" *"));
+  EXPECT_THAT(timed_line, Not(HasSubstr("*")));
+  EXPECT_THAT(parent_line, HasSubstr(" *"));
+}
+
+// Sample rates must be positive integers.
+TEST(SamplingDeathTest, InvalidRateTest) {
+  setenv("VERNIER_SAMPLE_RATE", "0", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid VERNIER_SAMPLE_RATE.");
+  unsetenv("VERNIER_SAMPLE_RATE");
+}
+
+// Region rates must be given as region=rate pairs.
+TEST(SamplingDeathTest, InvalidRegionRateTest) {
+  setenv("VERNIER_SAMPLE_REGIONS", "Tortiglioni=5,Paccheri", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid VERNIER_SAMPLE_REGIONS.");
+  unsetenv("VERNIER_SAMPLE_REGIONS");
+}
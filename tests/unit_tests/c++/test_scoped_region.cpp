@@ -0,0 +1,80 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "vernier.h"
+
+//
+//  Tests for scoped (RAII) regions.
+//
+
+// A scoped region is stopped when it goes out of scope.
+TEST(ScopedRegionTest, ScopeTest) {
+
+  meto::vernier.init();
+
+  for (int i = 0; i < 3; ++i) {
+    VERNIER_SCOPED_REGION("Penne");
+  }
+
+  auto const hash = meto::vernier.start("Penne");
+  meto::vernier.stop(hash);
+  EXPECT_EQ(meto::vernier.get_call_count(hash, 0), 4);
+
+  meto::vernier.finalize();
+}
+
+// Nested scoped regions record child time in the parent.
+TEST(ScopedRegionTest, NestedTest) {
+
+  meto::vernier.init();
+
+  {
+    VERNIER_SCOPED_REGION("Rigatoni");
+    {
+      VERNIER_SCOPED_REGION("Ziti");
+    }
+  }
+
+  auto const parent_hash = meto::vernier.start("Rigatoni");
+  auto const child_hash = meto::vernier.start("Ziti");
+  meto::vernier.stop(child_hash);
+  meto::vernier.stop(parent_hash);
+
+  EXPECT_EQ(meto::vernier.get_call_count(parent_hash, 0), 2);
+  EXPECT_EQ(meto::vernier.get_call_count(child_hash, 0), 2);
+  EXPECT_GT(meto::vernier.get_child_walltime(parent_hash, 0), 0.0);
+
+  meto::vernier.finalize();
+}
+
+// Regions are stopped when the scope is left by an exception, leaving the
+// traceback consistent for the enclosing region.
+TEST(ScopedRegionTest, ExceptionTest) {
+
+  meto::vernier.init();
+
+  auto const handle_outer = meto::vernier.register_region("Bucatini");
+  auto const handle_inner = meto::vernier.register_region("Linguine");
+
+  meto::vernier.start(handle_outer);
+  try {
+    meto::ScopedRegion const region(handle_inner);
+    throw std::runtime_error("Overcooked");
+  } catch (std::runtime_error const &) {
+  }
+  meto::vernier.stop(handle_outer);
+
+  auto const hash = meto::vernier.start("Linguine");
+  meto::vernier.stop(hash);
+  EXPECT_EQ(meto::vernier.get_call_count(hash, 0), 2);
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 3);
+
+  meto::vernier.finalize();
+}
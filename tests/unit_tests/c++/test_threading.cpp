@@ -0,0 +1,154 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "vernier.h"
+
+//
+//  Tests for threads created outside OpenMP.
+//
+
+// Thread IDs for non-OpenMP threads start after those of the OpenMP team.
+static int first_extra_tid() {
+  int tid = 1;
+#ifdef _OPENMP
+  tid = omp_get_max_threads();
+#endif
+  return tid;
+}
+
+// CPU time used by the calling thread, in seconds.
+static double thread_cpu_time() {
+  struct timespec point;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &point);
+  return static_cast<double>(point.tv_sec) +
+         static_cast<double>(point.tv_nsec) * 1.0e-9;
+}
+
+// Mean CPU time per calliper pair, when num_threads threads run callipers at
+// the same time.
+static double calliper_cost(int const num_threads) {
+  constexpr int num_calls = 200000;
+
+  std::vector<double> costs(static_cast<size_t>(num_threads));
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&costs, i]() {
+      auto const handle = meto::vernier.register_region("Tortellini");
+
+      // Warm up, so that thread registration is not timed.
+      meto::vernier.start(handle);
+      meto::vernier.stop(handle);
+
+      double const start_time = thread_cpu_time();
+      for (int j = 0; j < num_calls; ++j) {
+        meto::vernier.start(handle);
+        meto::vernier.stop(handle);
+      }
+      costs[static_cast<size_t>(i)] =
+          (thread_cpu_time() - start_time) / num_calls;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  double mean_cost = 0.0;
+  for (auto const cost : costs) {
+    mean_cost += cost / num_threads;
+  }
+  return mean_cost;
+}
+
+// Each std::thread gets its own thread ID and region records.
+TEST(ThreadingTest, StdThreadTest) {
+
+  meto::vernier.init();
+
+  auto const main_hash = meto::vernier.start("Spaghetti");
+  meto::vernier.stop(main_hash);
+
+  // Run the threads one after the other, so that thread IDs are predictable.
+  constexpr int num_threads = 3;
+  for (int i = 0; i < num_threads; ++i) {
+    size_t hash = 0;
+    std::thread thread([i, &hash]() {
+      for (int j = 0; j <= i; ++j) {
+        hash = meto::vernier.start("Spaghetti");
+        meto::vernier.stop(hash);
+      }
+    });
+    thread.join();
+
+    int const tid = first_extra_tid() + i;
+    EXPECT_EQ(meto::vernier.get_call_count(hash, tid), i + 1);
+    EXPECT_EQ(meto::vernier.get_decorated_region_name(hash, tid),
+              "Spaghetti@" + std::to_string(tid));
+  }
+
+  EXPECT_EQ(meto::vernier.get_call_count(main_hash, 0), 1);
+
+  meto::vernier.finalize();
+}
+
+// Concurrent std::threads do not interfere with one another.
+TEST(ThreadingTest, ConcurrentStdThreadTest) {
+
+  meto::vernier.init();
+
+  constexpr int num_threads = 4;
+  constexpr int num_calls = 100;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < num_calls; ++j) {
+        auto const outer = meto::vernier.start("Vermicelli");
+        auto const inner = meto::vernier.start("Capellini");
+        meto::vernier.stop(inner);
+        meto::vernier.stop(outer);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < num_threads; ++i) {
+    EXPECT_EQ(meto::vernier.get_prof_call_count(first_extra_tid() + i),
+              2 * num_calls);
+  }
+  EXPECT_EQ(meto::vernier.get_prof_call_count(0), 0);
+
+  meto::vernier.finalize();
+}
+
+// The cost of a calliper pair, on each thread, does not grow with the number
+// of threads. Threads would slow one another down if their profiler state
+// shared cache lines.
+TEST(ThreadingTest, CalliperCostScalingTest) {
+
+  meto::vernier.init();
+  double const serial_cost = calliper_cost(1);
+  meto::vernier.finalize();
+
+  meto::vernier.init();
+  double const parallel_cost = calliper_cost(8);
+  meto::vernier.finalize();
+
+  // Generous tolerance, since the threads may share cores.
+  EXPECT_LT(parallel_cost, 3.0 * serial_cost + 1.0e-7);
+}
@@ -0,0 +1,163 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "vernier.h"
+
+using ::testing::ExitedWithCode;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+//
+//  Tests for throttling, in which tiny, frequently called regions stop being
+//  timed.
+//
+
+// A tiny region stops accumulating time once throttled, but its calls are
+// still counted. A longer region is unaffected.
+TEST(ThrottlingTest, ThrottleTest) {
+  setenv("VERNIER_THROTTLE_CALLS", "100", 1);
+  setenv("VERNIER_THROTTLE_USEC", "5", 1);
+  meto::vernier.init();
+
+  auto const hash_slow = meto::vernier.start("Lasagne");
+  std::this_thread::sleep_for(std::chrono::microseconds(20));
+  meto::vernier.stop(hash_slow);
+
+  size_t hash_tiny = 0;
+  for (int i = 0; i < 100; ++i) {
+    hash_tiny = meto::vernier.start("Stelline");
+    meto::vernier.stop(hash_tiny);
+  }
+  double const throttled_total =
+      meto::vernier.get_total_walltime(hash_tiny, 0);
+
+  for (int i = 0; i < 900; ++i) {
+    hash_tiny = meto::vernier.start("Stelline");
+    meto::vernier.stop(hash_tiny);
+  }
+
+  for (int i = 0; i < 149; ++i) {
+    auto const hash = meto::vernier.start("Lasagne");
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+    meto::vernier.stop(hash);
+  }
+
+  EXPECT_EQ(meto::vernier.get_call_count(hash_tiny, 0), 1000);
+  EXPECT_DOUBLE_EQ(meto::vernier.get_total_walltime(hash_tiny, 0),
+                   throttled_total);
+  EXPECT_EQ(meto::vernier.get_call_count(hash_slow, 0), 150);
+  EXPECT_GE(meto::vernier.get_total_walltime(hash_slow, 0), 150 * 20.0e-6);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_THROTTLE_CALLS");
+  unsetenv("VERNIER_THROTTLE_USEC");
+}
+
+// Throttled regions are marked in the output.
+TEST(ThrottlingTest, OutputTest) {
+  setenv("VERNIER_THROTTLE_CALLS", "10", 1);
+  setenv("VERNIER_OUTPUT_FILENAME", "vernier-throttling", 1);
+  meto::vernier.init();
+
+  auto const hash_parent = meto::vernier.start("Cavatappi");
+  for (int i = 0; i < 20; ++i) {
+    auto const hash = meto::vernier.start("Anelli");
+    meto::vernier.stop(hash);
+  }
+  meto::vernier.stop(hash_parent);
+
+  meto::vernier.write();
+  meto::vernier.finalize();
+  unsetenv("VERNIER_THROTTLE_CALLS");
+  unsetenv("VERNIER_OUTPUT_FILENAME");
+
+  std::ifstream file("vernier-throttling-0");
+  std::stringstream contents;
+  contents << file.rdbuf();
+  file.close();
+  std::remove("vernier-throttling-0");
+
+  std::string const output = contents.str();
+  EXPECT_THAT(output, HasSubstr("Throttling: on."));
+
+  std::string throttled_line;
+  std::string parent_line;
+  std::istringstream lines(output);
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (line.rfind("Anelli@0", 0) == 0) {
+      throttled_line = line;
+    } else if (line.rfind("Cavatappi@0", 0) == 0) {
+      parent_line = line;
+    }
+  }
+  EXPECT_THAT(throttled_line, HasSubstr(" #"));
+  EXPECT_THAT(parent_line, Not(HasSubstr("#")));
+}
+
+// In the Dr Hook format, the marker comes before the routine name, which
+// stays the last field for the post-processing tools.
+TEST(ThrottlingTest, DrhookOutputTest) {
+  setenv("VERNIER_THROTTLE_CALLS", "10", 1);
+  setenv("VERNIER_OUTPUT_FORMAT", "drhook", 1);
+  setenv("VERNIER_OUTPUT_FILENAME", "vernier-throttling-drhook", 1);
+  meto::vernier.init();
+
+  for (int i = 0; i < 20; ++i) {
+    auto const hash = meto::vernier.start("Anelli");
+    meto::vernier.stop(hash);
+  }
+
+  meto::vernier.write();
+  meto::vernier.finalize();
+  unsetenv("VERNIER_THROTTLE_CALLS");
+  unsetenv("VERNIER_OUTPUT_FORMAT");
+  unsetenv("VERNIER_OUTPUT_FILENAME");
+
+  std::ifstream file("vernier-throttling-drhook-0");
+  std::stringstream contents;
+  contents << file.rdbuf();
+  file.close();
+  std::remove("vernier-throttling-drhook-0");
+
+  std::string throttled_line;
+  std::istringstream lines(contents.str());
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (line.find("Anelli@0") != std::string::npos) {
+      throttled_line = line;
+    }
+  }
+  EXPECT_THAT(throttled_line, HasSubstr(" #    Anelli@0"));
+  EXPECT_EQ(throttled_line.substr(throttled_line.size() - 8), "Anelli@0");
+}
+
+// The call threshold must be a positive integer.
+TEST(ThrottlingDeathTest, InvalidCallsTest) {
+  setenv("VERNIER_THROTTLE_CALLS", "-5", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid VERNIER_THROTTLE_CALLS.");
+  unsetenv("VERNIER_THROTTLE_CALLS");
+}
+
+// The time threshold must be a positive number.
+TEST(ThrottlingDeathTest, InvalidUsecTest) {
+  setenv("VERNIER_THROTTLE_USEC", "fast", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid VERNIER_THROTTLE_USEC.");
+  unsetenv("VERNIER_THROTTLE_USEC");
+}
@@ -0,0 +1,233 @@
+/*----------------------------------------------------------------------------*\
+ (c) Crown copyright 2026 Met Office. All rights reserved.
+ The file LICENCE, distributed with this code, contains details of the terms
+ under which the code may be used.
+\*----------------------------------------------------------------------------*/
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "output_helpers.h"
+#include "vernier.h"
+
+using ::testing::ExitedWithCode;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+//
+//  Tests for separating warm-up calls from the steady state.
+//
+
+namespace {
+
+// Writes the profile, and returns the whitespace-separated fields of the line
+// for the given decorated region name. The whole output is returned through
+// the second argument.
+std::vector<std::string> write_and_find(std::string const &region,
+                                        std::string &output) {
+  setenv("VERNIER_OUTPUT_FILENAME", "vernier-warmup", 1);
+  meto::vernier.write();
+  unsetenv("VERNIER_OUTPUT_FILENAME");
+
+  output = read_output("vernier-warmup-0");
+  auto const region_lines = find_region_lines(output, region);
+  if (region_lines.empty()) {
+    return {};
+  }
+  return region_lines.front();
+}
+
+} // namespace
+
+// The first calls of each region are reported in the warm-up columns only.
+TEST(WarmupTest, WarmupCallsTest) {
+  setenv("VERNIER_WARMUP_CALLS", "2", 1);
+  meto::vernier.init();
+
+  for (int call = 0; call < 5; ++call) {
+    auto const hash = meto::vernier.start("Pappardelle");
+    meto::vernier.stop(hash);
+  }
+  auto const hash = meto::vernier.start("Orzo");
+  meto::vernier.stop(hash);
+
+  std::string output;
+  auto const fields = write_and_find("Pappardelle@0", output);
+  ASSERT_EQ(fields.size(), 7);
+  EXPECT_EQ(fields[4], "3");
+  EXPECT_EQ(fields[6], "2");
+
+  // A region with fewer calls than that has only warm-up calls, and zero times
+  // elsewhere.
+  auto const orzo = write_and_find("Orzo@0", output);
+  ASSERT_EQ(orzo.size(), 7);
+  EXPECT_EQ(std::stod(orzo[1]), 0.0);
+  EXPECT_EQ(std::stod(orzo[2]), 0.0);
+  EXPECT_EQ(orzo[4], "0");
+  EXPECT_EQ(orzo[6], "1");
+  EXPECT_THAT(output, HasSubstr("Warm-up: on. The first 2 calls"));
+
+  // The stored times are left as measured.
+  EXPECT_EQ(meto::vernier.get_call_count(
+                meto::hash_region_name("Pappardelle"), 0),
+            5);
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_WARMUP_CALLS");
+}
+
+// Slow warm-up calls do not show in the steady-state times.
+TEST(WarmupTest, WarmupTimeTest) {
+  setenv("VERNIER_WARMUP_CALLS", "1", 1);
+  meto::vernier.init();
+
+  auto const hash_outer = meto::vernier.start("Linguine");
+  for (int call = 0; call < 3; ++call) {
+    auto const hash = meto::vernier.start("Tagliatelle");
+    if (call == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    meto::vernier.stop(hash);
+  }
+  meto::vernier.stop(hash_outer);
+
+  std::string output;
+  auto const fields = write_and_find("Tagliatelle@0", output);
+  ASSERT_EQ(fields.size(), 7);
+  EXPECT_LT(std::stod(fields[2]), 0.01);
+  EXPECT_GT(std::stod(fields[5]), 0.04);
+  EXPECT_EQ(fields[4], "2");
+  EXPECT_EQ(fields[6], "1");
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_WARMUP_CALLS");
+}
+
+// Calls that end before the steady state is marked are warm-up calls.
+TEST(WarmupTest, MarkSteadyStateTest) {
+  meto::vernier.init();
+
+  auto const hash_outer = meto::vernier.start("Vermicelli");
+  for (int call = 0; call < 7; ++call) {
+    if (call == 3) {
+      meto::vernier.mark_steady_state();
+    }
+    auto const hash = meto::vernier.start("Spaghetti");
+    meto::vernier.stop(hash);
+  }
+  auto const hash_late = meto::vernier.start("Bucatini");
+  meto::vernier.stop(hash_late);
+  meto::vernier.stop(hash_outer);
+
+  std::string output;
+  auto const fields = write_and_find("Spaghetti@0", output);
+  ASSERT_EQ(fields.size(), 7);
+  EXPECT_EQ(fields[4], "4");
+  EXPECT_EQ(fields[6], "3");
+
+  // Regions open at the mark, or first met after it, are in the steady state.
+  auto const outer = write_and_find("Vermicelli@0", output);
+  ASSERT_EQ(outer.size(), 7);
+  EXPECT_EQ(outer[4], "1");
+  EXPECT_EQ(outer[6], "0");
+  auto const late = write_and_find("Bucatini@0", output);
+  ASSERT_EQ(late.size(), 7);
+  EXPECT_EQ(late[4], "1");
+  EXPECT_EQ(late[6], "0");
+  EXPECT_THAT(output, HasSubstr("Warm-up: on. Calls that ended before the "
+                                "steady state was marked are left out"));
+
+  meto::vernier.finalize();
+}
+
+// A thread running callipers while the steady state is marked applies the
+// mark to its own records, at its next stop calliper.
+TEST(WarmupTest, MarkSteadyStateThreadTest) {
+  meto::vernier.init();
+
+  std::atomic<int> phase = 0;
+  size_t hash = 0;
+  std::thread thread([&phase, &hash]() {
+    for (int call = 0; call < 7; ++call) {
+      if (call == 3) {
+        phase = 1;
+        while (phase != 2) {
+          std::this_thread::yield();
+        }
+      }
+      hash = meto::vernier.start("Penne");
+      meto::vernier.stop(hash);
+    }
+  });
+  while (phase != 1) {
+    std::this_thread::yield();
+  }
+  meto::vernier.mark_steady_state();
+  phase = 2;
+  thread.join();
+
+  int tid = 1;
+#ifdef _OPENMP
+  tid = omp_get_max_threads();
+#endif
+  std::string output;
+  auto const fields = write_and_find(
+      meto::vernier.get_decorated_region_name(hash, tid), output);
+  ASSERT_EQ(fields.size(), 7);
+  EXPECT_EQ(fields[4], "4");
+  EXPECT_EQ(fields[6], "3");
+
+  meto::vernier.finalize();
+}
+
+// The Dr Hook format keeps the routine name last.
+TEST(WarmupTest, DrhookTest) {
+  setenv("VERNIER_WARMUP_CALLS", "1", 1);
+  setenv("VERNIER_OUTPUT_FORMAT", "drhook", 1);
+  meto::vernier.init();
+
+  for (int call = 0; call < 3; ++call) {
+    auto const hash = meto::vernier.start("Macaroni");
+    meto::vernier.stop(hash);
+  }
+
+  std::string output;
+  auto const fields = write_and_find("Macaroni@0", output);
+  ASSERT_EQ(fields.size(), 11);
+  EXPECT_EQ(fields[5], "2");
+  EXPECT_EQ(fields[9], "1");
+
+  meto::vernier.finalize();
+  unsetenv("VERNIER_OUTPUT_FORMAT");
+  unsetenv("VERNIER_WARMUP_CALLS");
+}
+
+// Without warm-up, there are no warm-up columns.
+TEST(WarmupTest, NoWarmupTest) {
+  meto::vernier.init();
+
+  auto const hash = meto::vernier.start("Gnocchi");
+  meto::vernier.stop(hash);
+
+  std::string output;
+  auto const fields = write_and_find("Gnocchi@0", output);
+  EXPECT_EQ(fields.size(), 5);
+  EXPECT_THAT(output, Not(HasSubstr("Warm-up")));
+
+  meto::vernier.finalize();
+}
+
+// The number of warm-up calls must be a positive integer.
+TEST(WarmupDeathTest, InvalidValueTest) {
+  setenv("VERNIER_WARMUP_CALLS", "-3", 1);
+  EXPECT_EXIT(meto::vernier.init(), ExitedWithCode(EXIT_FAILURE),
+              "Invalid VERNIER_WARMUP_CALLS.");
+  unsetenv("VERNIER_WARMUP_CALLS");
+}